@@ -0,0 +1,50 @@
+#include "BenchmarkBaseline.hpp"
+
+#include <cstdio>
+
+namespace shelly::benchmarks
+{
+
+Baseline readBaseline(const std::string& path) {
+    Baseline baseline;
+    std::FILE* file = std::fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        return baseline;
+    }
+
+    char line[512];
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        char name[128];
+        char reference[128];
+        double ratio;
+        if (line[0] != '#' && std::sscanf(line, "%127s %127s %lf", name, reference, &ratio) == 3) {
+            baseline[BaselineKey{name, reference}] = ratio;
+        }
+    }
+
+    std::fclose(file);
+    return baseline;
+}
+
+bool writeBaseline(const std::string& path, std::string_view header, const Baseline& ratios) {
+    std::string contents(header);
+    for (const auto& [key, ratio] : ratios) {
+        char line[512];
+        std::snprintf(line, sizeof(line), "%s %s %.3f\n", key.name.c_str(), key.reference.c_str(), ratio);
+        contents += line;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    return std::fclose(file) == 0 && written;
+}
+
+std::string baseName(const std::string& path) {
+    std::size_t slash = path.rfind('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace shelly::benchmarks
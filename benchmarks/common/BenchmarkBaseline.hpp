@@ -0,0 +1,36 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace shelly::benchmarks
+{
+
+/// @brief Identifies a baseline ratio: the benchmark case, and the reference shell Shelly was compared with.
+struct BaselineKey {
+    std::string name;
+    std::string reference;
+
+    bool operator<(const BaselineKey& other) const {
+        return std::pair(name, reference) < std::pair(other.name, other.reference);
+    }
+};
+
+/// @brief Ratios of Shelly's time to reference shells' times.
+using Baseline = std::map<BaselineKey, double>;
+
+/// @brief Reads baseline ratios. Lines have the form "<name> <reference shell> <ratio>"; '#' starts a comment.
+/// @return Ratios read. Empty if the file cannot be read.
+Baseline readBaseline(const std::string& path);
+
+/// @brief Writes baseline ratios in the form readBaseline reads.
+/// @param header Comment lines written first, each starting with '#' and ending with a newline.
+/// @return True if the file was written.
+bool writeBaseline(const std::string& path, std::string_view header, const Baseline& ratios);
+
+/// @brief Returns the file name of a shell path, which identifies the shell in a baseline.
+std::string baseName(const std::string& path);
+
+} // namespace shelly::benchmarks
@@ -0,0 +1,131 @@
+#include "BenchmarkProcess.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace shelly::benchmarks
+{
+
+namespace {
+
+/// @brief Time a shell may go without writing before it is given up on, in milliseconds.
+constexpr int promptTimeout = 10000;
+
+std::vector<char*> makeArgumentVector(const std::string& shell, const std::vector<std::string>& arguments) {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(shell.c_str()));
+    for (const std::string& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+    return argv;
+}
+
+} // namespace
+
+double spawnAndWait(const std::string& shell, const std::vector<std::string>& arguments) {
+    std::vector<char*> argv = makeArgumentVector(shell, arguments);
+
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_addopen(&fileActions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_addopen(&fileActions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&fileActions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    pid_t pid;
+    int spawnResult = posix_spawn(&pid, shell.c_str(), &fileActions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&fileActions);
+    if (spawnResult != 0) {
+        return -1;
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return -1;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+double spawnUntilPrompt(const std::string& shell, const std::vector<std::string>& arguments, std::string_view prompt) {
+    int terminal = posix_openpt(O_RDWR | O_NOCTTY);
+    if (terminal == -1) {
+        return -1;
+    }
+    const char* terminalName = grantpt(terminal) == 0 && unlockpt(terminal) == 0 ? ptsname(terminal) : nullptr;
+    if (terminalName == nullptr) {
+        close(terminal);
+        return -1;
+    }
+
+    std::vector<char*> argv = makeArgumentVector(shell, arguments);
+
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_addclose(&fileActions, terminal);
+    posix_spawn_file_actions_addopen(&fileActions, STDIN_FILENO, terminalName, O_RDWR | O_NOCTTY, 0);
+    posix_spawn_file_actions_adddup2(&fileActions, STDIN_FILENO, STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&fileActions, STDIN_FILENO, STDERR_FILENO);
+
+    auto start = std::chrono::steady_clock::now();
+
+    pid_t pid;
+    int spawnResult = posix_spawn(&pid, shell.c_str(), &fileActions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&fileActions);
+    if (spawnResult != 0) {
+        close(terminal);
+        return -1;
+    }
+
+    /// @note Once the shell has exited and closed the terminal, reading fails. A shell that waits for input without
+    ///       writing the expected prompt is killed once it has been silent for promptTimeout.
+    std::string output;
+    bool prompted = false;
+    while (!prompted) {
+        pollfd terminalEvents{terminal, POLLIN, 0};
+        int ready = poll(&terminalEvents, 1, promptTimeout);
+        if (ready == -1 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            kill(pid, SIGKILL);
+            break;
+        }
+
+        char buffer[4096];
+        ssize_t readCount = read(terminal, buffer, sizeof(buffer));
+        if (readCount == -1 && errno == EINTR) {
+            continue;
+        }
+        if (readCount <= 0) {
+            break;
+        }
+        output.append(buffer, static_cast<std::size_t>(readCount));
+        prompted = output.find(prompt) != std::string::npos;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    close(terminal);
+    int status;
+    if (waitpid(pid, &status, 0) != pid || !prompted) {
+        return -1;
+    }
+
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+} // namespace shelly::benchmarks
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace shelly::benchmarks
+{
+
+/// @brief Spawns the shell once, with stdin, stdout and stderr attached to /dev/null, and waits for it to exit.
+/// @return Elapsed wall time from spawn to exit in microseconds, or -1 if the shell could not be spawned or exited
+///         with a failure.
+double spawnAndWait(const std::string& shell, const std::vector<std::string>& arguments);
+
+/// @brief Spawns the shell once with stdin, stdout and stderr attached to a new pseudo-terminal, so it starts as an
+///        interactive shell, and reads its output until the prompt appears. The terminal is then closed, which ends
+///        the input of the shell, and the shell is waited for.
+/// @param prompt Output that shows the shell is ready for input.
+/// @return Elapsed wall time from spawn until the prompt was read in microseconds, or -1 if the shell could not be
+///         spawned or stopped writing before the prompt.
+double spawnUntilPrompt(const std::string& shell, const std::vector<std::string>& arguments, std::string_view prompt);
+
+} // namespace shelly::benchmarks
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BenchmarkBaseline.hpp"
+#include "BenchmarkProcess.hpp"
+
+/// @brief Runs a corpus of workloads through Shelly and through locally installed reference shells (bash, dash),
+///        and fails if Shelly got slower relative to them than a stored baseline allows.
+///
+///        Usage: DifferentialBenchmark [options] <shell> [reference shell...]
+///
+///          --work-dir <dir>         Directory for generated workload files (default: current directory).
+///          --baseline <file>        Baseline ratios to compare against.
+///          --update-baseline        Write the measured ratios to the baseline file instead of comparing.
+///          --tolerance <fraction>   Allowed slowdown over a baseline ratio (default: 0.3).
+///
+///        Ratios of Shelly's time to a reference shell's time on the same machine are compared, not absolute
+///        times, so one baseline is usable across machines. Each measurement is the best of several runs, and a
+///        workload fails only if it stays over its limit when measured again.
+///        Without reference shells, times are reported and the benchmark exits with 77 (skipped).
+
+namespace {
+
+using namespace shelly::benchmarks;
+
+/// @brief Exit status that tells CTest the benchmark was skipped.
+constexpr int skippedStatus = 77;
+
+/// @brief Number of times every workload is measured per shell. The fastest run is kept.
+constexpr int repetitions = 5;
+
+/// @brief Number of times a workload is measured before it counts as regressed.
+constexpr int attempts = 3;
+
+struct Workload {
+    const char* name;
+    std::vector<std::string> arguments;     ///< Arguments of the shell, relative to the work directory.
+    int invocations;                        ///< Number of times the shell is spawned per measurement.
+};
+
+bool writeFile(const std::string& path, const std::string& contents) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    return std::fclose(file) == 0 && written;
+}
+
+/// @brief Generates the workload scripts. Only constructs every shell supports are used, so all shells run the same scripts.
+/// @return True if every file was written.
+bool generateWorkloadFiles() {
+    /// @note Fork-heavy loop, unrolled: every line spawns an external program.
+    std::string forkLoop;
+    for (int i = 0; i < 1000; i++) {
+        forkLoop += "/bin/true\n";
+    }
+
+    /// @note Long pipelines: 64 stages moving 1 MiB of data.
+    std::string pipelineInput;
+    while (pipelineInput.size() < 1024 * 1024) {
+        pipelineInput += "the quick brown fox jumps over the lazy dog 0123456789 abcdefgh\n";
+    }
+    std::string pipelineLine = "cat pipeline-input.txt";
+    for (int stage = 0; stage < 62; stage++) {
+        pipelineLine += " | cat";
+    }
+    pipelineLine += " | wc -c\n";
+    std::string longPipeline;
+    for (int i = 0; i < 20; i++) {
+        longPipeline += pipelineLine;
+    }
+
+    /// @note Line-oriented input of 1M lines that the shell itself has to scan, as a here-document.
+    std::string hereDocumentLines = "wc -l <<EOF\n";
+    for (int i = 0; i < 1000000; i++) {
+        hereDocumentLines += "line " + std::to_string(i) + "\n";
+    }
+    hereDocumentLines += "EOF\n";
+
+    /// @note Argument lists of the size a large glob expands to.
+    std::string argumentLine = "/bin/echo";
+    for (int i = 0; i < 3000; i++) {
+        char name[32];
+        std::snprintf(name, sizeof(name), " file-%05d.txt", i);
+        argumentLine += name;
+    }
+    argumentLine += "\n";
+    std::string argumentList;
+    for (int i = 0; i < 100; i++) {
+        argumentList += argumentLine;
+    }
+
+    /// @note 10 MiB script of builtin commands and comments, dominated by reading and parsing.
+    std::string largeScript;
+    while (largeScript.size() < 10 * 1024 * 1024) {
+        largeScript += "# generated line " + std::to_string(largeScript.size()) + "\n";
+        largeScript += ": the quick brown fox jumps over the lazy dog\n";
+        largeScript += "true\n";
+    }
+
+    return writeFile("fork-loop.sh", forkLoop)
+        && writeFile("pipeline-input.txt", pipelineInput)
+        && writeFile("long-pipeline.sh", longPipeline)
+        && writeFile("here-document-lines.sh", hereDocumentLines)
+        && writeFile("argument-list.sh", argumentList)
+        && writeFile("large-script.sh", largeScript);
+}
+
+/// @brief Measures the workload once on every shell. Repetitions are interleaved across the shells, so a change in
+///        machine load during the measurement affects all of them alike.
+/// @return Best elapsed wall time per shell in milliseconds, or -1 for shells that failed to run.
+std::vector<double> measure(const std::vector<std::string>& shells, const Workload& workload) {
+    std::vector<double> best(shells.size(), -1);
+    std::vector<bool> failed(shells.size(), false);
+
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        for (std::size_t shell = 0; shell < shells.size(); shell++) {
+            if (failed[shell]) {
+                continue;
+            }
+
+            double elapsed = 0;
+            for (int invocation = 0; invocation < workload.invocations && !failed[shell]; invocation++) {
+                double invocationTime = spawnAndWait(shells[shell], workload.arguments);
+                failed[shell] = invocationTime < 0;
+                elapsed += invocationTime / 1000;
+            }
+
+            if (failed[shell]) {
+                best[shell] = -1;
+            } else {
+                best[shell] = best[shell] < 0 ? elapsed : std::min(best[shell], elapsed);
+            }
+        }
+    }
+
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string workDirectory = ".";
+    std::string baselinePath;
+    bool updateBaseline = false;
+    double tolerance = 0.3;
+    std::vector<std::string> shells;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--work-dir" && i + 1 < argc) {
+            workDirectory = argv[++i];
+        } else if (argument == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (argument == "--tolerance" && i + 1 < argc) {
+            tolerance = std::atof(argv[++i]);
+        } else if (argument == "--update-baseline") {
+            updateBaseline = true;
+        } else {
+            shells.push_back(argument);
+        }
+    }
+
+    if (shells.empty() || (updateBaseline && baselinePath.empty())) {
+        std::fprintf(stderr, "usage: %s [--work-dir <dir>] [--baseline <file>] [--update-baseline] [--tolerance <fraction>] <shell> [reference shell...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    mkdir(workDirectory.c_str(), 0777);
+    if (chdir(workDirectory.c_str()) != 0 || !generateWorkloadFiles()) {
+        std::fprintf(stderr, "differential: cannot generate workloads in %s\n", workDirectory.c_str());
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<Workload> workloads = {
+        {"fork-loop", {"fork-loop.sh"}, 1},
+        {"long-pipeline", {"long-pipeline.sh"}, 1},
+        {"here-document-lines", {"here-document-lines.sh"}, 1},
+        {"argument-list", {"argument-list.sh"}, 1},
+        {"large-script", {"large-script.sh"}, 1},
+        {"c-startup", {"-c", "true"}, 200},
+    };
+
+    Baseline baseline = baselinePath.empty() ? Baseline() : readBaseline(baselinePath);
+    Baseline ratios;
+    bool regressed = false;
+    bool compared = false;
+
+    for (const Workload& workload : workloads) {
+        /// @note A workload over its limit is measured again. Only a regression that every attempt shows fails the
+        ///       benchmark, so a burst of machine load during one measurement does not.
+        bool workloadRegressed = false;
+        for (int attempt = 1; attempt <= attempts && (attempt == 1 || workloadRegressed); attempt++) {
+            workloadRegressed = false;
+
+            std::vector<double> times = measure(shells, workload);
+            double shellyTime = times.front();
+            if (shellyTime < 0) {
+                std::fprintf(stderr, "differential/%s: %s failed to run\n", workload.name, shells.front().c_str());
+                return EXIT_FAILURE;
+            }
+            std::printf("differential/%s [%s]: %.1f ms%s\n", workload.name, baseName(shells.front()).c_str(), shellyTime,
+                attempt == 1 ? "" : " (measured again)");
+
+            for (std::size_t reference = 1; reference < shells.size(); reference++) {
+                std::string referenceName = baseName(shells[reference]);
+                double referenceTime = times[reference];
+                if (referenceTime <= 0) {
+                    std::printf("differential/%s [%s]: failed to run, not compared\n", workload.name, referenceName.c_str());
+                    continue;
+                }
+
+                double ratio = shellyTime / referenceTime;
+                BaselineKey key{workload.name, referenceName};
+                ratios[key] = ratio;
+                compared = true;
+
+                std::printf("differential/%s [%s]: %.1f ms, ratio %.2f", workload.name, referenceName.c_str(), referenceTime, ratio);
+                auto baselineRatio = baseline.find(key);
+                if (updateBaseline || baselineRatio == baseline.end()) {
+                    std::printf(updateBaseline ? "\n" : " (no baseline)\n");
+                    continue;
+                }
+
+                double limit = baselineRatio->second * (1 + tolerance);
+                bool withinLimit = ratio <= limit;
+                workloadRegressed |= !withinLimit;
+                std::printf(" (baseline %.2f, limit %.2f) %s\n", baselineRatio->second, limit, withinLimit ? "ok" : "over limit");
+            }
+            std::fflush(stdout);
+        }
+
+        if (workloadRegressed) {
+            std::printf("differential/%s: REGRESSED\n", workload.name);
+            regressed = true;
+        }
+    }
+
+    if (updateBaseline) {
+        constexpr std::string_view header =
+            "# Differential benchmark baseline: Shelly's time divided by the reference shell's time.\n"
+            "# Regenerate with `cmake --build <build dir> --target update-differential-baseline`.\n"
+            "# <workload> <reference shell> <ratio>\n";
+        if (!writeBaseline(baselinePath, header, ratios)) {
+            std::fprintf(stderr, "differential: cannot write %s\n", baselinePath.c_str());
+            return EXIT_FAILURE;
+        }
+        std::printf("differential: baseline written to %s\n", baselinePath.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    if (!compared) {
+        std::printf("differential: no reference shell ran, nothing to compare\n");
+        return skippedStatus;
+    }
+    return regressed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
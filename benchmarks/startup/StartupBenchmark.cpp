@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BenchmarkBaseline.hpp"
+#include "BenchmarkProcess.hpp"
+
+/// @brief Measures Shelly startup time, and fails if Shelly got slower relative to locally installed reference shells
+///        (e.g. dash) than a stored baseline allows.
+///
+///        Usage: StartupBenchmark [options] <shell> [reference shell...]
+///
+///          --baseline <file>        Baseline ratios to compare against.
+///          --update-baseline        Write the measured ratios to the baseline file instead of comparing.
+///          --tolerance <fraction>   Allowed slowdown over a baseline ratio (default: 0.3).
+///
+///        The exec-to-prompt case runs the shell on a pseudo-terminal, so it takes the interactive startup path, and
+///        stops the clock when the prompt is read. Reference shells are given Shelly's prompt as PS1. The -c cases run
+///        with stdin, stdout and stderr attached to /dev/null, until the shell exits.
+///        Every case is timed by its median over many runs, and the ratio of Shelly's median to a reference shell's is
+///        compared with the baseline. A case fails only if it stays over its limit when measured again.
+///        Without reference shells, times are reported and the benchmark exits with 77 (skipped).
+
+namespace {
+
+using namespace shelly::benchmarks;
+
+/// @brief Exit status that tells CTest the benchmark was skipped.
+constexpr int skippedStatus = 77;
+
+/// @brief Number of times every case is run per shell.
+constexpr int iterations = 200;
+
+/// @brief Number of times a case is measured before it counts as regressed.
+constexpr int attempts = 3;
+
+/// @brief Prompt Shelly writes when it is ready for input.
+constexpr std::string_view prompt = "shelly$ ";
+
+struct BenchmarkCase {
+    const char* name;
+    std::vector<std::string> arguments;
+    bool interactive;   ///< True if the shell runs on a terminal until it prompts, instead of until it exits.
+};
+
+/// @brief Runs the benchmark case on every shell. Runs are interleaved across the shells, so a change in machine load
+///        during the measurement affects all of them alike.
+/// @return Median elapsed wall time per shell in microseconds, or -1 for shells that failed to run.
+std::vector<double> measure(const std::vector<std::string>& shells, const BenchmarkCase& benchmarkCase) {
+    std::vector<std::vector<double>> samples(shells.size());
+    std::vector<bool> failed(shells.size(), false);
+
+    for (int i = 0; i < iterations; i++) {
+        for (std::size_t shell = 0; shell < shells.size(); shell++) {
+            if (failed[shell]) {
+                continue;
+            }
+            double elapsed = benchmarkCase.interactive
+                ? spawnUntilPrompt(shells[shell], benchmarkCase.arguments, prompt)
+                : spawnAndWait(shells[shell], benchmarkCase.arguments);
+            failed[shell] = elapsed < 0;
+            samples[shell].push_back(elapsed);
+        }
+    }
+
+    std::vector<double> medians(shells.size(), -1);
+    for (std::size_t shell = 0; shell < shells.size(); shell++) {
+        if (failed[shell]) {
+            continue;
+        }
+
+        std::vector<double>& shellSamples = samples[shell];
+        std::sort(shellSamples.begin(), shellSamples.end());
+        double mean = 0;
+        for (double sample : shellSamples) {
+            mean += sample / shellSamples.size();
+        }
+        medians[shell] = shellSamples[shellSamples.size() / 2];
+
+        std::printf("startup/%s [%s]: min %.1f us, median %.1f us, mean %.1f us (%d runs)\n",
+            benchmarkCase.name, baseName(shells[shell]).c_str(), shellSamples.front(), medians[shell], mean, iterations);
+    }
+    return medians;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string baselinePath;
+    bool updateBaseline = false;
+    double tolerance = 0.3;
+    std::vector<std::string> shells;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (argument == "--tolerance" && i + 1 < argc) {
+            tolerance = std::atof(argv[++i]);
+        } else if (argument == "--update-baseline") {
+            updateBaseline = true;
+        } else {
+            shells.push_back(argument);
+        }
+    }
+
+    if (shells.empty() || (updateBaseline && baselinePath.empty())) {
+        std::fprintf(stderr, "usage: %s [--baseline <file>] [--update-baseline] [--tolerance <fraction>] <shell> [reference shell...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /// @note Every shell prompts with the same bytes, so the prompt marks the end of startup for all of them.
+    setenv("PS1", std::string(prompt).c_str(), 1);
+
+    const std::vector<BenchmarkCase> cases = {
+        {"exec-to-prompt", {}, true},
+        {"c-true", {"-c", "true"}, false},
+        {"c-redirection", {"-c", "/bin/true > /dev/null"}, false},
+    };
+
+    Baseline baseline = baselinePath.empty() ? Baseline() : readBaseline(baselinePath);
+    Baseline ratios;
+    bool regressed = false;
+    bool compared = false;
+
+    for (const BenchmarkCase& benchmarkCase : cases) {
+        bool caseRegressed = false;
+        for (int attempt = 1; attempt <= attempts && (attempt == 1 || caseRegressed); attempt++) {
+            caseRegressed = false;
+
+            std::vector<double> medians = measure(shells, benchmarkCase);
+            double median = medians.front();
+            if (median < 0) {
+                std::fprintf(stderr, "startup/%s: %s failed to run\n", benchmarkCase.name, shells.front().c_str());
+                return EXIT_FAILURE;
+            }
+
+            for (std::size_t reference = 1; reference < shells.size(); reference++) {
+                std::string referenceName = baseName(shells[reference]);
+                double referenceMedian = medians[reference];
+                if (referenceMedian <= 0) {
+                    std::printf("startup/%s [%s]: failed to run, not compared\n", benchmarkCase.name, referenceName.c_str());
+                    continue;
+                }
+
+                double ratio = median / referenceMedian;
+                BaselineKey key{benchmarkCase.name, referenceName};
+                ratios[key] = ratio;
+                compared = true;
+
+                std::printf("startup/%s: median ratio to %s %.2f", benchmarkCase.name, referenceName.c_str(), ratio);
+                auto baselineRatio = baseline.find(key);
+                if (updateBaseline || baselineRatio == baseline.end()) {
+                    std::printf(updateBaseline ? "\n" : " (no baseline)\n");
+                    continue;
+                }
+
+                double limit = baselineRatio->second * (1 + tolerance);
+                bool withinLimit = ratio <= limit;
+                caseRegressed |= !withinLimit;
+                std::printf(" (baseline %.2f, limit %.2f) %s\n", baselineRatio->second, limit, withinLimit ? "ok" : "over limit");
+            }
+            std::fflush(stdout);
+        }
+
+        if (caseRegressed) {
+            std::printf("startup/%s: REGRESSED\n", benchmarkCase.name);
+            regressed = true;
+        }
+    }
+
+    if (updateBaseline) {
+        constexpr std::string_view header =
+            "# Startup benchmark baseline: Shelly's median time divided by the reference shell's median time.\n"
+            "# Regenerate with `cmake --build <build dir> --target update-startup-baseline`.\n"
+            "# <case> <reference shell> <ratio>\n";
+        if (!writeBaseline(baselinePath, header, ratios)) {
+            std::fprintf(stderr, "startup: cannot write %s\n", baselinePath.c_str());
+            return EXIT_FAILURE;
+        }
+        std::printf("startup: baseline written to %s\n", baselinePath.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    if (!compared) {
+        std::printf("startup: no reference shell ran, nothing to compare\n");
+        return skippedStatus;
+    }
+    return regressed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
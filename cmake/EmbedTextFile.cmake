@@ -0,0 +1,37 @@
+# Writes a C++ header that embeds a text file as an inline constexpr std::string_view.
+#
+# Usage:
+#   cmake -DINPUT=<text file> -DOUTPUT=<header> -DNAMESPACE=<namespace> -DVARIABLE=<name> -P EmbedTextFile.cmake
+
+foreach(argument INPUT OUTPUT NAMESPACE VARIABLE)
+    if(NOT DEFINED ${argument})
+        message(FATAL_ERROR "EmbedTextFile: ${argument} is not set")
+    endif()
+endforeach()
+
+set(delimiter "shelly_embed")
+
+file(READ "${INPUT}" contents)
+string(FIND "${contents}" ")${delimiter}\"" delimiterPosition)
+if(NOT delimiterPosition EQUAL -1)
+    message(FATAL_ERROR "EmbedTextFile: ${INPUT} contains the raw string delimiter \")${delimiter}\"\"")
+endif()
+
+file(WRITE "${OUTPUT}.tmp"
+"#pragma once
+
+// Generated from ${INPUT} - do not edit.
+
+#include <string_view>
+
+namespace ${NAMESPACE}
+{
+
+inline constexpr std::string_view ${VARIABLE} = R\"${delimiter}(${contents})${delimiter}\";
+
+} // namespace ${NAMESPACE}
+")
+
+# Avoid touching the header when the contents did not change, so dependents are not rebuilt.
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${OUTPUT}.tmp" "${OUTPUT}")
+file(REMOVE "${OUTPUT}.tmp")
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <cstdint>
+#include <cstddef>
 
 namespace shelly::ast
 {
@@ -14,21 +14,21 @@ public:
     /// @brief Instantiate a location inside an issued command.
     /// @param linePosition line number.
     /// @param charPosition position within the line, measured in characters.
-    explicit Location(uint16_t linePosition, uint16_t charPosition): linePosition(linePosition), charPosition(charPosition) {}
+    explicit constexpr Location(std::size_t linePosition, std::size_t charPosition): linePosition(linePosition), charPosition(charPosition) {}
     
     /// @brief Returns the line number.
-    /// @return 16-bit integer line number.
-    inline uint16_t getLinePosition() { return linePosition; }
+    /// @return Line number.
+    constexpr std::size_t getLinePosition() const { return linePosition; }
 
     /// @brief Returns the position within the line, measured in characters.
-    /// @return 16-bit integer character position.
-    inline uint16_t getCharPosition() { return charPosition; }
+    /// @return Character position.
+    constexpr std::size_t getCharPosition() const { return charPosition; }
 
 protected:
 private:
 
-    uint16_t linePosition;
-    uint16_t charPosition;
+    std::size_t linePosition;
+    std::size_t charPosition;
 
 };
 
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <optional>
+#include <string_view>
 
 #include "Token.hpp"
 
@@ -8,30 +11,33 @@ namespace shelly::ast {
 
 /// @brief Responsible for lexing an issued command from the terminal. State is mutable, and methods have side-effects.
 ///        
-///        Lexer should be instantiated on a per-input basis.
+///        Lexer should be instantiated on a per-input basis. It does not copy the input, and tokens
+///        refer to the input, so lexing never allocates. The input must outlive the lexer and its tokens.
+///
+///        All methods are constexpr, so an input known at compile time can be lexed during constant evaluation.
 /// @todo Add support for quoted strings, double quoted strings, tick quoted strings, and escaped characters.
 class Lexer {
 public:
 
     /// @brief Instantiate a lexer for an issued command from the terminal.
-    /// @param input Issued command.
-    explicit Lexer(std::string input);
+    /// @param input Issued command. Must outlive the lexer and its tokens.
+    explicit constexpr Lexer(std::string_view input);
 
     /// @brief Returns the next token, and consumes it.
     ///
     ///        If lexer reached the end of the issued command, optional will be returned with no value inside.
     /// @return Optional that contains the next token if it exists and the end of the issued command is not reached.
-    std::optional<Token> consume();
+    constexpr std::optional<Token> consume();
 
     /// @brief Returns the next token to be consumed, without consuming it.
     ///
     ///        If lexer reached the end of the issued command, optional will be returned with no value inside.
     /// @return Optional that contains the next token to be consumed if it exists.
-    std::optional<Token> peek();
+    constexpr std::optional<Token> peek();
 
     /// @brief Returns true if end of the issued command is not reached. Otherwise, false.
     /// @return True if end of the issued command is not reached. Otherwise, false.
-    bool hasTokensLeft();
+    constexpr bool hasTokensLeft();
 
 protected:
 private:
@@ -39,8 +45,8 @@ private:
     std::optional<Token> nextToken;
     bool nextTokenLoaded = false;
 
-    std::string input;
-    uint16_t charPointer = 0;
+    std::string_view input;
+    std::size_t charPointer = 0;
 
     /// @brief Result of an operation inside the Lexer (method, function, lambda).  
     /// @note Success indicates the operation completed successfully.  
@@ -50,17 +56,157 @@ private:
         Success,                  ///< Operation completed successfully  
     };
 
-    inline char getAndAdvanceChar();
-    inline char getAndRetainChar();
-    inline void revertAdvanceChar();
-    inline bool hasCharsLeft();
+    constexpr char getAndAdvanceChar();
+    constexpr char getAndRetainChar();
+    constexpr void revertAdvanceChar();
+    constexpr bool hasCharsLeft();
 
-    void skipWhitespace();
+    constexpr void skipWhitespace();
 
-    void loadNextToken();
+    constexpr void loadNextToken();
 
-    inline OperationResult loadStringLiteral(Location tokenLocation);
+    constexpr OperationResult loadStringLiteral(Location tokenLocation);
 
 };
 
-} // namespace shelly::ast
\ No newline at end of file
+constexpr Lexer::Lexer(std::string_view input) : input(input) {}
+
+constexpr std::optional<Token> Lexer::consume() {
+    loadNextToken();
+    if (!nextTokenLoaded) {
+        return std::nullopt;
+    }
+    
+    nextTokenLoaded = false;
+    return nextToken;
+}
+
+constexpr std::optional<Token> Lexer::peek() {
+    loadNextToken();
+    if (!nextTokenLoaded) {
+        return std::nullopt;
+    }
+
+    return nextToken;
+}
+
+constexpr bool Lexer::hasTokensLeft() {
+    if (nextTokenLoaded) {
+        return true;
+    }
+    skipWhitespace();
+    return hasCharsLeft();
+}
+
+constexpr void Lexer::loadNextToken() {
+
+    if (nextTokenLoaded) {
+        return;
+    }
+
+    if (!hasTokensLeft()) {
+        return;
+    }
+    
+    /// @note This lexer is intended for single-line command input, so all tokens  
+    ///       are reported as being on line 1 by design. If multi-line input is ever  
+    ///       supported, line tracking should be added and used here instead of the  
+    ///       hard-coded line number.
+    Location tokenLocation = Location(1, charPointer + 1);
+
+    OperationResult tokenLexingResult = OperationResult::Success;
+
+    char currChar = getAndRetainChar();
+    switch (currChar) {
+        case '|': {
+            getAndAdvanceChar();
+            nextToken = Token(TokenKind::PIPE, tokenLocation);
+            break;
+        }
+        case '>': {
+            getAndAdvanceChar();
+            nextToken = Token(TokenKind::OUTPUT_REDIRECTION, tokenLocation);
+            break;
+        }
+        case '<': {
+            getAndAdvanceChar();
+            if (!hasCharsLeft() || getAndRetainChar() != '<') {
+                nextToken = Token(TokenKind::INPUT_REDIRECTION, tokenLocation);
+                break;
+            }
+            getAndAdvanceChar();
+            if (hasCharsLeft() && getAndRetainChar() == '<') {
+                getAndAdvanceChar();
+                nextToken = Token(TokenKind::HERE_STRING, tokenLocation);
+            } else if (hasCharsLeft() && getAndRetainChar() == '-') {
+                getAndAdvanceChar();
+                nextToken = Token(TokenKind::HERE_DOCUMENT_STRIP_TABS, tokenLocation);
+            } else {
+                nextToken = Token(TokenKind::HERE_DOCUMENT, tokenLocation);
+            }
+            break;
+        }
+        case '2': {
+            getAndAdvanceChar();
+            if (hasCharsLeft() && getAndRetainChar() == '>') {
+                getAndAdvanceChar();
+                nextToken = Token(TokenKind::ERROR_REDIRECTION, tokenLocation);
+                break;
+            }
+            revertAdvanceChar();
+        }
+        [[fallthrough]];
+        default: {
+            tokenLexingResult = loadStringLiteral(tokenLocation);
+            break;
+        }
+    }
+
+    if (tokenLexingResult != OperationResult::Success) {
+        nextToken = Token(TokenKind::UNKNOWN, tokenLocation);
+    }
+    nextTokenLoaded = true;
+}
+
+constexpr char Lexer::getAndAdvanceChar() {
+    assert(charPointer != input.size() && "Char pointer is at the input's end - getAndAdvanceChar");
+    return input[charPointer++];
+}
+
+constexpr char Lexer::getAndRetainChar() {
+    assert(charPointer != input.size() && "Char pointer is at the input's end - getAndRetainChar");
+    return input[charPointer];
+}
+
+constexpr void Lexer::revertAdvanceChar() {
+    assert(charPointer != 0 && "Cannot revert advancing of char because char pointer points at the input start");
+    charPointer--;
+}
+
+constexpr bool Lexer::hasCharsLeft() {
+    return charPointer < input.size();
+}
+
+constexpr void Lexer::skipWhitespace() {
+    while (hasCharsLeft() && isWhitespace(getAndRetainChar())) {
+        getAndAdvanceChar();
+    }
+}
+
+constexpr Lexer::OperationResult Lexer::loadStringLiteral(Location tokenLocation) {
+    std::size_t tokenStart = charPointer;
+
+    while (hasCharsLeft()) {
+        char c = getAndRetainChar();
+        if (isWhitespace(c) || c == '|' || c == '>' || c == '<') {
+            break;
+        }
+        getAndAdvanceChar();
+    }
+
+    nextToken = Token(TokenKind::STRING_LITERAL, tokenLocation, input.substr(tokenStart, charPointer - tokenStart));
+
+    return OperationResult::Success;
+}
+
+} // namespace shelly::ast
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <string>
+#include <string_view>
 #include <cassert>
 
 #include "TokenKind.hpp"
@@ -16,13 +16,16 @@ namespace shelly::ast
 ///
 ///        This is expected to be compressed into a smaller form if memory footprint
 ///        is important.
+///
+///        Token data is a view into the lexed input, so copying a token never allocates.
+///        The input must outlive the token.
 class Token {
 public:
 
     /// @brief Instantiates a token without data.
     /// @param tokenKind Token kind.
     /// @param location  Token location.
-    Token(TokenKind tokenKind, Location location) : tokenKind(tokenKind), location(location)
+    constexpr Token(TokenKind tokenKind, Location location) : tokenKind(tokenKind), location(location)
     {
         assert(!isStringLiteral() && "You must assign data to a STRING_LITERAL token!");
     }
@@ -31,41 +34,41 @@ public:
     /// @param tokenKind Token kind.
     /// @param location  Token location.
     /// @param data      Token data.
-    Token(TokenKind tokenKind, Location location, const std::string& data) : tokenKind(tokenKind), location(location), data(data)
+    constexpr Token(TokenKind tokenKind, Location location, std::string_view data) : tokenKind(tokenKind), location(location), data(data)
     {
         assert(isStringLiteral() && "Cannot assign data to a non-STRING_LITERAL token!");
     }
 
     /// @brief Returns kind of this token.
     /// @return Kind of this token.
-    inline TokenKind getKind() const { return tokenKind; }
+    constexpr TokenKind getKind() const { return tokenKind; }
 
     /// @brief Check if token is of kind tokenKind.
     /// @param tokenKind Token kind for which the check is performed.
     /// @return True if the token kinds match. Otherwise, false.
-    inline bool is(TokenKind tokenKind) const { return this->tokenKind == tokenKind; }
+    constexpr bool is(TokenKind tokenKind) const { return this->tokenKind == tokenKind; }
 
     /// @brief Check if the token is a string literal token.
     /// @return True if the token is a string literal token.
-    inline bool isStringLiteral() const { return this->tokenKind == TokenKind::STRING_LITERAL; }
+    constexpr bool isStringLiteral() const { return this->tokenKind == TokenKind::STRING_LITERAL; }
     
     /// @brief Returns token data.
     /// @return Token data.
-    inline const std::string& getData() const {
+    constexpr std::string_view getData() const {
         assert(isStringLiteral() && "Cannot get data from a non-STRING_LITERAL token!");
         return data;
     }
 
     /// @brief Returns token location information.
     /// @return Token location information.
-    inline Location getLocation() const { return location; }
+    constexpr Location getLocation() const { return location; }
 
 protected:
 private:
 
     TokenKind tokenKind;
     Location location;
-    std::string data;
+    std::string_view data;
 
 };
 
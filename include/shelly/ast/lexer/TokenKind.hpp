@@ -1,6 +1,6 @@
 #pragma once
 
-#include <set>
+#include <string_view>
 
 namespace shelly::ast
 {
@@ -10,12 +10,21 @@ enum TokenKind {
     STRING_LITERAL,
     PIPE,
     INPUT_REDIRECTION,
+    HERE_DOCUMENT,
+    HERE_DOCUMENT_STRIP_TABS,
+    HERE_STRING,
     OUTPUT_REDIRECTION,
     ERROR_REDIRECTION,
     UNKNOWN
 };
 
+/// @brief Characters that separate tokens inside a single command.
 /// @todo migrate whitespace set to a config file.
-const std::set<char> whitespace = {' ', '\t', '\n', '\r', '\v', '\f'};
+inline constexpr std::string_view whitespace = " \t\n\r\v\f";
 
-} // namespace shelly::ast
\ No newline at end of file
+/// @brief Check if a character separates tokens inside a single command.
+/// @param c Character for which the check is performed.
+/// @return True if the character is whitespace. Otherwise, false.
+constexpr bool isWhitespace(char c) { return whitespace.find(c) != std::string_view::npos; }
+
+} // namespace shelly::ast
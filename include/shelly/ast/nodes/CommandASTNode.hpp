@@ -1,9 +1,107 @@
 #pragma once
 
+#include <cassert>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace shelly::ast
 {
 
-/// @todo Implement the AST.
-class CommandASTNode;
+/// @brief Here-document or here-string that is the input of a command.
+struct HereDocument {
+
+    /// @brief Operator that introduced the here-document.
+    enum class Kind {
+        Document,               ///< `<<word`: body lines follow the command, up to a line equal to the delimiter.
+        DocumentStripTabs,      ///< `<<-word`: like Document, but leading tabs are stripped from body lines and the delimiter line.
+        String,                 ///< `<<<word`: body is the word followed by a newline.
+    };
+
+    Kind kind;
+    std::string word;           ///< Delimiter of a here-document, or contents of a here-string.
+    std::string_view body;      ///< Body lines of a here-document, as they appear in the input. Refers to the input.
+
+    /// @brief Check if the body follows the command in the input, and ends with a delimiter line.
+    /// @return True for here-documents. False for here-strings.
+    constexpr bool isDelimited() const { return kind != Kind::String; }
+};
+
+/// @brief Single command inside a pipeline, together with its redirections.
+///
+///        All methods are constexpr, so the node can be built during constant evaluation.
+class CommandASTNode {
+public:
+
+    /// @brief Instantiate a command without arguments and redirections.
+    constexpr CommandASTNode() = default;
+
+    /// @brief Appends an argument to the command. The first argument is the program name.
+    /// @param argument Argument to append.
+    constexpr void addArgument(std::string_view argument) { arguments.emplace_back(argument); }
+
+    /// @brief Returns command arguments, including the program name.
+    /// @return Command arguments.
+    constexpr const std::vector<std::string>& getArguments() const { return arguments; }
+
+    /// @brief Redirects the command's input from the given path. Replaces previous input redirection and here-document.
+    /// @param path Input redirection path.
+    constexpr void setInputRedirection(std::string_view path) {
+        inputRedirection.emplace(path);
+        hereDocument.reset();
+    }
+
+    /// @brief Returns the input redirection path.
+    /// @return Optional that contains the input redirection path if the input is redirected.
+    constexpr const std::optional<std::string>& getInputRedirection() const { return inputRedirection; }
+
+    /// @brief Makes a here-document or here-string the command's input. Replaces previous input redirection and here-document.
+    ///
+    ///        The body of a here-document is attached later, with setHereDocumentBody, once the lines following the command are read.
+    /// @param kind Operator that introduced the here-document.
+    /// @param word Delimiter of a here-document, or contents of a here-string.
+    constexpr void setHereDocument(HereDocument::Kind kind, std::string_view word) {
+        hereDocument.emplace(HereDocument{kind, std::string(word), {}});
+        inputRedirection.reset();
+    }
+
+    /// @brief Attaches the body of the command's here-document.
+    /// @param body Body lines, as they appear in the input. Must outlive the command.
+    constexpr void setHereDocumentBody(std::string_view body) {
+        assert(hereDocument.has_value() && "Command has no here-document - setHereDocumentBody");
+        hereDocument->body = body;
+    }
+
+    /// @brief Returns the here-document or here-string that is the command's input.
+    /// @return Optional that contains the here-document if the command's input is one.
+    constexpr const std::optional<HereDocument>& getHereDocument() const { return hereDocument; }
+
+    /// @brief Redirects the command's output to the given path. Replaces previous output redirection.
+    /// @param path Output redirection path.
+    constexpr void setOutputRedirection(std::string_view path) { outputRedirection.emplace(path); }
+
+    /// @brief Returns the output redirection path.
+    /// @return Optional that contains the output redirection path if the output is redirected.
+    constexpr const std::optional<std::string>& getOutputRedirection() const { return outputRedirection; }
+
+    /// @brief Redirects the command's error output to the given path. Replaces previous error redirection.
+    /// @param path Error redirection path.
+    constexpr void setErrorRedirection(std::string_view path) { errorRedirection.emplace(path); }
+
+    /// @brief Returns the error redirection path.
+    /// @return Optional that contains the error redirection path if the error output is redirected.
+    constexpr const std::optional<std::string>& getErrorRedirection() const { return errorRedirection; }
+
+protected:
+private:
+
+    std::vector<std::string> arguments;
+    std::optional<std::string> inputRedirection;
+    std::optional<HereDocument> hereDocument;
+    std::optional<std::string> outputRedirection;
+    std::optional<std::string> errorRedirection;
+
+};
 
 } // namespace shelly::ast
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "CommandASTNode.hpp"
+
+namespace shelly::ast
+{
+
+/// @brief Commands connected with pipes, in the order they were issued.
+///
+///        All methods are constexpr, so the node can be built during constant evaluation.
+class PipelineASTNode {
+public:
+
+    /// @brief Instantiate a pipeline without commands.
+    constexpr PipelineASTNode() = default;
+
+    /// @brief Appends a command to the end of the pipeline.
+    /// @param command Command to append.
+    constexpr void addCommand(CommandASTNode&& command) { commands.push_back(std::move(command)); }
+
+    /// @brief Returns commands of the pipeline.
+    /// @return Commands of the pipeline.
+    constexpr const std::vector<CommandASTNode>& getCommands() const { return commands; }
+
+    /// @brief Returns commands of the pipeline, so here-document bodies can be attached to them.
+    /// @return Commands of the pipeline.
+    constexpr std::vector<CommandASTNode>& getCommands() { return commands; }
+
+    /// @brief Marks the pipeline as prefixed with the time keyword.
+    /// @param timed True if resource usage of the pipeline should be reported.
+    constexpr void setTimed(bool timed) { this->timed = timed; }
+
+    /// @brief Check if the pipeline is prefixed with the time keyword.
+    /// @return True if resource usage of the pipeline should be reported. Otherwise, false.
+    constexpr bool isTimed() const { return timed; }
+
+protected:
+private:
+
+    std::vector<CommandASTNode> commands;
+    bool timed = false;
+
+};
+
+} // namespace shelly::ast
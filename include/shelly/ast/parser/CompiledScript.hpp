@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Parser.hpp"
+
+namespace shelly::ast
+{
+
+/// @brief Sizes of the static storage needed to hold a compiled script.
+struct CompiledScriptSize {
+    std::size_t pipelineCount = 0;
+    std::size_t commandCount = 0;
+    std::size_t wordCount = 0;
+    std::size_t charCount = 0;
+    bool valid = true;
+};
+
+/// @brief Word of a compiled script, stored as a slice of the script's character storage.
+struct CompiledWord {
+    uint32_t offset;
+    uint32_t length;
+};
+
+/// @brief Command of a compiled script. Redirections hold a word index, or noWord if the stream is not redirected.
+struct CompiledCommand {
+    static constexpr uint32_t noWord = UINT32_MAX;
+
+    uint32_t firstArgument;
+    uint32_t argumentCount;
+    uint32_t inputRedirection = noWord;
+    uint32_t outputRedirection = noWord;
+    uint32_t errorRedirection = noWord;
+};
+
+/// @brief Pipeline of a compiled script, stored as a slice of the script's commands.
+struct CompiledPipeline {
+    uint32_t firstCommand;
+    uint32_t commandCount;
+    bool timed = false;
+};
+
+namespace detail {
+
+/// @brief Lexes and parses a script line by line, skipping blank lines and lines starting with '#'.
+///
+///        The lexer is intended for single-line command input, so every line is lexed separately.
+/// @todo Support here-documents and here-strings. Compiled scripts have no storage for them, so they are rejected.
+/// @param source Script source.
+/// @return Optional that contains the parsed pipelines if every line of the script is well formed.
+constexpr std::optional<std::vector<PipelineASTNode>> parseScript(std::string_view source) {
+    std::vector<PipelineASTNode> pipelines;
+
+    while (!source.empty()) {
+        std::size_t lineEnd = source.find('\n');
+        std::string_view line = source.substr(0, lineEnd);
+        source.remove_prefix(lineEnd == std::string_view::npos ? source.size() : lineEnd + 1);
+
+        if (isBlankOrCommentLine(line)) {
+            continue;
+        }
+
+        Lexer lexer(line);
+        std::optional<PipelineASTNode> pipeline = Parser(lexer).parse();
+        if (!pipeline.has_value()) {
+            return std::nullopt;
+        }
+        for (const CommandASTNode& command : pipeline->getCommands()) {
+            if (command.getHereDocument()) {
+                return std::nullopt;
+            }
+        }
+        pipelines.push_back(std::move(*pipeline));
+    }
+
+    return pipelines;
+}
+
+/// @brief Computes the static storage needed to hold the compiled script.
+/// @param source Script source.
+/// @return Sizes of the static storage. If the script is malformed, valid is set to false.
+constexpr CompiledScriptSize measureScript(std::string_view source) {
+    CompiledScriptSize size;
+
+    std::optional<std::vector<PipelineASTNode>> pipelines = parseScript(source);
+    if (!pipelines.has_value()) {
+        size.valid = false;
+        return size;
+    }
+
+    auto countWord = [&size](const std::string& word) {
+        size.wordCount++;
+        size.charCount += word.size();
+    };
+
+    for (const PipelineASTNode& pipeline : *pipelines) {
+        size.pipelineCount++;
+        for (const CommandASTNode& command : pipeline.getCommands()) {
+            size.commandCount++;
+            for (const std::string& argument : command.getArguments()) {
+                countWord(argument);
+            }
+            if (command.getInputRedirection()) { countWord(*command.getInputRedirection()); }
+            if (command.getOutputRedirection()) { countWord(*command.getOutputRedirection()); }
+            if (command.getErrorRedirection()) { countWord(*command.getErrorRedirection()); }
+        }
+    }
+
+    return size;
+}
+
+} // namespace detail
+
+/// @brief Script that was lexed and parsed during constant evaluation, flattened into static storage.
+///
+///        Memory allocated during constant evaluation cannot outlive it, so the parsed pipelines are
+///        copied into fixed-size arrays whose sizes are computed by a separate measuring pass.
+///        Use compileScript to instantiate it.
+template <CompiledScriptSize size>
+class CompiledScript {
+public:
+
+    /// @brief Lexes and parses the script, and copies the result into static storage.
+    /// @param source Script source. Must be the same source the size was measured from.
+    consteval explicit CompiledScript(std::string_view source) {
+        std::vector<PipelineASTNode> parsedPipelines = detail::parseScript(source).value();
+
+        uint32_t pipelineIndex = 0;
+        uint32_t commandIndex = 0;
+        uint32_t wordIndex = 0;
+        uint32_t charIndex = 0;
+
+        auto storeWord = [&](const std::string& word) {
+            words[wordIndex] = CompiledWord{charIndex, static_cast<uint32_t>(word.size())};
+            for (char c : word) {
+                characters[charIndex++] = c;
+            }
+            return wordIndex++;
+        };
+
+        for (const PipelineASTNode& pipeline : parsedPipelines) {
+            pipelines[pipelineIndex++] = CompiledPipeline{commandIndex, static_cast<uint32_t>(pipeline.getCommands().size()), pipeline.isTimed()};
+            for (const CommandASTNode& command : pipeline.getCommands()) {
+                CompiledCommand& compiledCommand = commands[commandIndex++];
+                compiledCommand = CompiledCommand{wordIndex, static_cast<uint32_t>(command.getArguments().size())};
+                for (const std::string& argument : command.getArguments()) {
+                    storeWord(argument);
+                }
+                if (command.getInputRedirection()) { compiledCommand.inputRedirection = storeWord(*command.getInputRedirection()); }
+                if (command.getOutputRedirection()) { compiledCommand.outputRedirection = storeWord(*command.getOutputRedirection()); }
+                if (command.getErrorRedirection()) { compiledCommand.errorRedirection = storeWord(*command.getErrorRedirection()); }
+            }
+        }
+    }
+
+    /// @brief Returns pipelines of the script, in the order they appear in the source.
+    /// @return Pipelines of the script.
+    constexpr std::span<const CompiledPipeline> getPipelines() const { return pipelines; }
+
+    /// @brief Returns commands of the given pipeline.
+    /// @param pipeline Pipeline of this script.
+    /// @return Commands of the pipeline.
+    constexpr std::span<const CompiledCommand> getCommands(const CompiledPipeline& pipeline) const {
+        return std::span<const CompiledCommand>(commands).subspan(pipeline.firstCommand, pipeline.commandCount);
+    }
+
+    /// @brief Returns an argument of the given command. The argument at index 0 is the program name.
+    /// @param command  Command of this script.
+    /// @param argument Argument index, less than command.argumentCount.
+    /// @return Argument of the command.
+    constexpr std::string_view getArgument(const CompiledCommand& command, std::size_t argument) const {
+        assert(argument < command.argumentCount && "Argument index is out of range - getArgument");
+        return getWord(command.firstArgument + argument);
+    }
+
+    /// @brief Returns a redirection target of a command.
+    /// @param redirection One of the redirection fields of a command of this script.
+    /// @return Optional that contains the redirection target if the stream is redirected.
+    constexpr std::optional<std::string_view> getRedirection(uint32_t redirection) const {
+        if (redirection == CompiledCommand::noWord) {
+            return std::nullopt;
+        }
+        return getWord(redirection);
+    }
+
+protected:
+private:
+
+    std::array<char, size.charCount> characters{};
+    std::array<CompiledWord, size.wordCount> words{};
+    std::array<CompiledCommand, size.commandCount> commands{};
+    std::array<CompiledPipeline, size.pipelineCount> pipelines{};
+
+    constexpr std::string_view getWord(uint32_t word) const {
+        return std::string_view(characters.data() + words[word].offset, words[word].length);
+    }
+
+};
+
+/// @brief Lexes and parses a script during constant evaluation.
+///
+///        Fails to compile if any line of the script is malformed.
+/// @tparam source Script source, with static storage duration.
+/// @return Compiled script.
+template <const std::string_view& source>
+consteval auto compileScript() {
+    constexpr CompiledScriptSize size = detail::measureScript(source);
+    static_assert(size.valid, "Script contains a malformed command!");
+    return CompiledScript<size>(source);
+}
+
+} // namespace shelly::ast
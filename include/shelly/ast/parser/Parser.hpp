@@ -1,22 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <utility>
+
 #include "shelly/ast/lexer/Lexer.hpp"
 #include "shelly/ast/nodes/CommandASTNode.hpp"
-#include <optional>
+#include "shelly/ast/nodes/PipelineASTNode.hpp"
 
 namespace shelly::ast
 {
-    
+
+/// @brief Check if a line of a script contains no command: it is blank, or its first non-whitespace character is '#'.
+/// @param line Line of a script.
+/// @return True if the line contains no command. Otherwise, false.
+constexpr bool isBlankOrCommentLine(std::string_view line) {
+    std::size_t firstChar = 0;
+    while (firstChar < line.size() && isWhitespace(line[firstChar])) {
+        firstChar++;
+    }
+    return firstChar == line.size() || line[firstChar] == '#';
+}
+
+/// @brief Keyword that prefixes a pipeline whose resource usage should be reported.
+inline constexpr std::string_view timeKeyword = "time";
+
+/// @brief Responsible for parsing tokens of an issued command into a pipeline. Consumes tokens from the lexer.
+///
+///        Bodies of here-documents follow the issued command, so the parser only records their delimiters.
+///        The time keyword is recognized only as the first token of the issued command.
+///        All methods are constexpr, so an input known at compile time can be parsed during constant evaluation.
 class Parser {
 public:
 
-    Parser(Lexer& lexer) : lexer(lexer) {}
+    /// @brief Instantiate a parser that consumes tokens from the given lexer.
+    /// @param lexer Lexer of the issued command.
+    constexpr Parser(Lexer& lexer) : lexer(lexer) {}
 
-    std::optional<CommandASTNode> parse();
+    /// @brief Parses all tokens left in the lexer.
+    ///
+    ///        An issued command without tokens is parsed into a pipeline without commands.
+    ///        If the issued command is malformed, optional will be returned with no value inside.
+    /// @return Optional that contains the parsed pipeline if the issued command is well formed.
+    constexpr std::optional<PipelineASTNode> parse();
 
 protected:
 private:
 
     Lexer& lexer;
 
+    /// @brief Consumes the target of a redirection token.
+    /// @return Optional that contains the redirection target if the next token is a string literal.
+    constexpr std::optional<std::string_view> parseRedirectionTarget();
+
 };
 
+constexpr std::optional<PipelineASTNode> Parser::parse() {
+    PipelineASTNode pipeline;
+    CommandASTNode command;
+
+    std::optional<Token> firstToken = lexer.peek();
+    if (firstToken.has_value() && firstToken->isStringLiteral() && firstToken->getData() == timeKeyword) {
+        lexer.consume();
+        pipeline.setTimed(true);
+    }
+
+    while (lexer.hasTokensLeft()) {
+        Token token = lexer.consume().value();
+        switch (token.getKind()) {
+            case TokenKind::STRING_LITERAL: {
+                command.addArgument(token.getData());
+                break;
+            }
+            case TokenKind::PIPE: {
+                if (command.getArguments().empty()) {
+                    return std::nullopt;
+                }
+                pipeline.addCommand(std::move(command));
+                command = CommandASTNode();
+                break;
+            }
+            case TokenKind::INPUT_REDIRECTION:
+            case TokenKind::OUTPUT_REDIRECTION:
+            case TokenKind::ERROR_REDIRECTION: {
+                std::optional<std::string_view> target = parseRedirectionTarget();
+                if (!target.has_value()) {
+                    return std::nullopt;
+                }
+                if (token.is(TokenKind::INPUT_REDIRECTION)) {
+                    command.setInputRedirection(*target);
+                } else if (token.is(TokenKind::OUTPUT_REDIRECTION)) {
+                    command.setOutputRedirection(*target);
+                } else {
+                    command.setErrorRedirection(*target);
+                }
+                break;
+            }
+            case TokenKind::HERE_DOCUMENT:
+            case TokenKind::HERE_DOCUMENT_STRIP_TABS:
+            case TokenKind::HERE_STRING: {
+                std::optional<std::string_view> word = parseRedirectionTarget();
+                if (!word.has_value()) {
+                    return std::nullopt;
+                }
+                if (token.is(TokenKind::HERE_DOCUMENT)) {
+                    command.setHereDocument(HereDocument::Kind::Document, *word);
+                } else if (token.is(TokenKind::HERE_DOCUMENT_STRIP_TABS)) {
+                    command.setHereDocument(HereDocument::Kind::DocumentStripTabs, *word);
+                } else {
+                    command.setHereDocument(HereDocument::Kind::String, *word);
+                }
+                break;
+            }
+            case TokenKind::UNKNOWN: {
+                return std::nullopt;
+            }
+        }
+    }
+
+    if (command.getArguments().empty()) {
+        /// @note A trailing pipe, or redirections without a program, leave the last command without arguments.
+        if (!pipeline.getCommands().empty() || command.getInputRedirection() || command.getHereDocument()
+            || command.getOutputRedirection() || command.getErrorRedirection()) {
+            return std::nullopt;
+        }
+        return pipeline;
+    }
+
+    pipeline.addCommand(std::move(command));
+    return pipeline;
+}
+
+constexpr std::optional<std::string_view> Parser::parseRedirectionTarget() {
+    std::optional<Token> target = lexer.consume();
+    if (!target.has_value() || !target->isStringLiteral()) {
+        return std::nullopt;
+    }
+    return target->getData();
+}
+
 } // namespace shelly::ast
@@ -1,23 +1,121 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace shelly::ast {
+
+class PipelineASTNode;
+
+}
+
+namespace shelly::platform {
+
+class IOEngine;
+class LineReader;
+
+}
+
 namespace shelly::core {
 
+class MetricsSink;
+struct PipelineMetrics;
+
 /// @brief Orchestrator class for the shell. Instantiates all of the components, and executes them as needed.
 ///        
-///        Contains entry point for Shelly after the config and log initialization is finsihed.
+///        Contains entry points for Shelly after the config and log initialization is finsihed.
+///        Components needed only by the interactive shell are initialized lazily, so non-interactive
+///        invocations (`shelly -c`, `shelly script.sh`, scripts piped to the standard input) skip them.
 class Shell {
 public:
 
-    /// @brief Instantiate Shelly.
+    /// @brief Instantiate Shelly. Initializes only the metrics sink, if one is configured by the environment.
     /// @todo Add logs and config classes that are initialized in main.
     Shell();
 
-    /// @brief Entry point for Shelly after the config and log initialization is finsihed.
+    ~Shell();
+
+    /// @brief Entry point for Shelly when neither a command string nor a script file is given.
+    ///
+    ///        Reads commands from the standard input. Interactive components are initialized only
+    ///        if the standard input is a terminal.
     /// @return Exit status of the program.
     int run();
 
+    /// @brief Entry point for `shelly -c`. Executes the command string non-interactively.
+    /// @param commandString Commands to execute, one pipeline per line.
+    /// @return Exit status of the program.
+    int runCommandString(std::string_view commandString);
+
+    /// @brief Entry point for `shelly script.sh`. Executes the script file non-interactively.
+    /// @param path Script file path.
+    /// @return Exit status of the program.
+    int runScriptFile(const std::string& path);
+
+    /// @brief Returns the exit status of the last executed pipeline.
+    /// @return Exit status of the last executed pipeline.
+    inline int getLastExitStatus() const { return lastExitStatus; }
+
+    /// @brief Requests the shell to stop executing commands and exit. Used by the exit builtin.
+    /// @param exitStatus Exit status of the program.
+    void requestExit(int exitStatus);
+
 protected:
 private:
+
+    int lastExitStatus = 0;
+    bool exitRequested = false;
+
+    std::unique_ptr<MetricsSink> metricsSink;
+    std::unique_ptr<platform::IOEngine> ioEngine;
+
+    /// @brief Returns the I/O engine, creating it on first use so invocations without redirections never set it up.
+    /// @return I/O engine of the shell.
+    platform::IOEngine& getIOEngine();
+
+    /// @brief Initializes the components needed only by the interactive shell, and runs the default rc script.
+    /// @todo Add terminal setup, history and completion.
+    void initializeInteractive();
+
+    /// @brief Reads and executes commands from the input, one line at a time, until the end of input or a read error.
+    ///
+    ///        Every line runs as soon as it is read, so commands from a slow producer are not held back, and a script
+    ///        that rewrites its own file keeps running from the point it has read up to, as in other shells.
+    ///        Execution of a non-interactive script stops at the first malformed line.
+    /// @param input       Input to read commands from.
+    /// @param interactive True if the input is a terminal. Then, every line is prompted for.
+    /// @return Exit status of the last executed pipeline, or 2 if a non-interactive script is malformed.
+    int runLines(platform::LineReader& input, bool interactive);
+
+    /// @brief Executes a script one line at a time, skipping blank lines and comments.
+    ///
+    ///        Execution stops at the first malformed line.
+    /// @param script Script source.
+    /// @return Exit status of the last executed pipeline, or 2 if the script is malformed.
+    int runScript(std::string_view script);
+
+    /// @brief Executes a single line of input.
+    /// @param line       Line to execute.
+    /// @param lineNumber Line number, used in error messages. Advanced past the here-document bodies that follow the line.
+    /// @param input      Input that follows the line. Bodies of the line's here-documents are consumed from its front.
+    /// @return False if the line is malformed. Otherwise, true.
+    bool executeLine(std::string_view line, std::size_t& lineNumber, std::string_view& input);
+
+    /// @brief Spawns all commands of the pipeline, connects them with pipes, and waits for them to exit.
+    ///
+    ///        Resource usage is reported if the pipeline is timed, and recorded if a metrics sink is configured.
+    /// @param pipeline Pipeline to execute.
+    /// @return Exit status of the last command of the pipeline.
+    int executePipeline(const ast::PipelineASTNode& pipeline);
+
+    /// @brief Executes the commands of the pipeline.
+    /// @param pipeline Pipeline to execute.
+    /// @param metrics  Receives resource usage of every command, or nullptr if it is not needed.
+    /// @return Exit status of the last command of the pipeline.
+    int executeCommands(const ast::PipelineASTNode& pipeline, PipelineMetrics* metrics);
+
 };
 
-} // namespace shelly::core
\ No newline at end of file
+} // namespace shelly::core
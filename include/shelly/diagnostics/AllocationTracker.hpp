@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+namespace shelly::diagnostics
+{
+
+/// @brief Check if allocation tracking is compiled in.
+///
+///        Tracking replaces the global operator new and operator delete of every executable that links
+///        the diagnostics_tracking library, or the diagnostics library when the SHELLY_ALLOCATION_TRACKING
+///        CMake option is ON. It is off by default. When it is disabled, every scope reports zero allocations.
+/// @return True if allocations are counted. Otherwise, false.
+bool isAllocationTrackingEnabled();
+
+/// @brief Counts heap allocations made by the current thread while the scope is alive.
+///
+///        Scopes can be nested, and every scope counts the allocations of its nested scopes.
+class AllocationScope {
+public:
+
+    /// @brief Starts counting allocations of the current thread.
+    AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    /// @brief Returns the number of operator new calls since the scope started.
+    /// @return Number of allocations.
+    std::size_t getAllocationCount() const;
+
+    /// @brief Returns the number of operator delete calls on non-null pointers since the scope started.
+    /// @return Number of deallocations.
+    std::size_t getDeallocationCount() const;
+
+    /// @brief Returns the number of bytes requested from operator new since the scope started.
+    /// @return Number of allocated bytes.
+    std::size_t getAllocatedBytes() const;
+
+protected:
+private:
+
+    std::size_t allocationCountAtStart;
+    std::size_t deallocationCountAtStart;
+    std::size_t allocatedBytesAtStart;
+
+};
+
+} // namespace shelly::diagnostics
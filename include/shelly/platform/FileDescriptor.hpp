@@ -1,9 +1,52 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
+
 namespace shelly::platform
 {
 
-/// @todo Implement this.
 class FileDescriptor;
 
+/// @brief API function for opening a file for reading.
+/// @param path File path.
+/// @return New file descriptor, or nullptr if the file could not be opened.
+std::unique_ptr<FileDescriptor> openFileForReading(const std::string& path);
+
+/// @brief API function for opening a file for writing. The file is created if it does not exist, and truncated otherwise.
+/// @param path File path.
+/// @return New file descriptor, or nullptr if the file could not be opened.
+std::unique_ptr<FileDescriptor> openFileForWriting(const std::string& path);
+
+/// @brief Platform independent file descriptor object. Owns the native handle, and closes it when destroyed.
+class FileDescriptor {
+public:
+
+    /// @brief Native handle type, wide enough to hold a POSIX file descriptor or a Windows HANDLE.
+    using NativeHandle = std::intptr_t;
+
+    /// @brief Native handle value that does not refer to an open file.
+    static constexpr NativeHandle invalidHandle = -1;
+
+    /// @brief Takes ownership of a native handle.
+    /// @param nativeHandle Native handle.
+    explicit FileDescriptor(NativeHandle nativeHandle) : nativeHandle(nativeHandle) {}
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    ~FileDescriptor();
+
+    /// @brief Returns the native handle, without giving up its ownership.
+    /// @return Native handle.
+    inline NativeHandle getNativeHandle() const { return nativeHandle; }
+
+protected:
+private:
+
+    NativeHandle nativeHandle;
+
+};
+
 } // namespace shelly::platform
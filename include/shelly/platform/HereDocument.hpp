@@ -0,0 +1,34 @@
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace shelly::platform {
+
+class FileDescriptor;
+
+/// @brief Largest here-document body that is passed through a pipe. Larger bodies are stored in anonymous memory.
+///
+///        A body of at most PIPE_BUF bytes always fits into an empty pipe, so the shell writes it
+///        before spawning the child, and never blocks on a pipe the child has not drained.
+#ifdef PIPE_BUF
+inline constexpr std::size_t pipedHereDocumentLimit = PIPE_BUF;
+#else
+inline constexpr std::size_t pipedHereDocumentLimit = 4096;
+#endif
+
+/// @brief API function for creating the input of a child from a here-document body.
+///
+///        Small bodies are written into a pipe, whose input end is closed before returning. Larger bodies are
+///        written into an anonymous memory file that is sealed against modification and rewound, so the child
+///        can also seek or map it. Nothing is ever written to disk.
+///        Windows has no such memory files, so there every body goes through a pipe, written by a helper thread
+///        while the child reads it.
+/// @param body Parts of the body, concatenated in order.
+/// @return Input for the child, or nullptr if it could not be created.
+std::unique_ptr<FileDescriptor> makeHereDocumentInput(std::span<const std::string_view> body);
+
+} // namespace shelly::platform
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+
+#include "FileDescriptor.hpp"
+
+namespace shelly::platform
+{
+
+class IOEngine;
+
+namespace detail {
+
+class IOEngineHandle;
+
+}
+
+/// @brief Mechanism an IOEngine uses to execute requests.
+enum class IOBackend {
+    IoUring,    ///< Whole batch is submitted to an io_uring with a single system call.
+    Blocking,   ///< Requests are executed one after another with blocking system calls.
+};
+
+/// @brief Single I/O operation submitted to an IOEngine. Results are filled in when its batch completes.
+struct IORequest {
+
+    /// @brief Kind of the operation.
+    enum class Operation {
+        OpenForReading, ///< Opens path for reading.
+        OpenForWriting, ///< Opens path for writing, creating or truncating the file.
+    };
+
+    Operation operation;
+    std::string path = {};                          ///< Path of the file to open.
+
+    std::unique_ptr<FileDescriptor> openedFile = {};    ///< Opened file, or nullptr if the open failed.
+    int error = 0;                                  ///< Error number of a failed operation. Otherwise, 0.
+
+    /// @brief Creates a request that opens a file for reading.
+    static IORequest openForReading(std::string path) { return IORequest{.operation = Operation::OpenForReading, .path = std::move(path)}; }
+
+    /// @brief Creates a request that opens a file for writing. The file is created if it does not exist, and truncated otherwise.
+    static IORequest openForWriting(std::string path) { return IORequest{.operation = Operation::OpenForWriting, .path = std::move(path)}; }
+};
+
+/// @brief API function for creating an I/O engine.
+///
+///        Uses blocking system calls by default. Setting up an io_uring costs more than the handful of opens
+///        a pipeline's redirections batch together, so the io_uring backend is only used when the
+///        SHELLY_IO_BACKEND environment variable is "io_uring", falling back to blocking system calls
+///        if it is unavailable. The backend is set up on first use, so creating an engine is cheap.
+/// @return New I/O engine.
+std::unique_ptr<IOEngine> makeIOEngine();
+
+/// @brief Platform independent engine that opens batches of files, such as the redirection targets of a pipeline.
+///
+///        Requests inside a batch may execute concurrently and in any order, so they must be independent
+///        of each other. Batching lets the io_uring backend replace a system call per request with a
+///        system call per batch. A batch of a single open is executed directly with a blocking system call,
+///        without setting up the backend.
+class IOEngine {
+public:
+
+    ~IOEngine();
+
+    /// @brief Returns the backend used by this engine.
+    /// @return Backend used by this engine.
+    IOBackend getBackend() const;
+
+    /// @brief Executes all requests, and waits until every one of them is complete.
+    /// @param requests Requests to execute. Their results are filled in.
+    void submit(std::span<IORequest> requests);
+
+protected:
+private:
+    explicit IOEngine(std::unique_ptr<detail::IOEngineHandle> ioEngineHandle);
+
+    std::unique_ptr<detail::IOEngineHandle> ioEngineHandle;
+    friend std::unique_ptr<IOEngine> makeIOEngine();
+};
+
+} // namespace shelly::platform
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace shelly::platform {
+
+class LineReader;
+
+namespace detail {
+
+class LineReaderHandle;
+
+}
+
+/// @brief API function for opening a file for reading one line at a time.
+/// @param path File path.
+/// @return New reader, or nullptr if the file could not be opened.
+std::unique_ptr<LineReader> openLineReader(const std::string& path);
+
+/// @brief API function for reading the standard input of the shell one line at a time.
+/// @return New reader, or nullptr if the standard input is closed.
+std::unique_ptr<LineReader> makeStandardInputLineReader();
+
+/// @brief Platform independent buffered reader of lines.
+///
+///        The input is read incrementally, a buffer at a time, and never held whole. A script that rewrites its own file
+///        while running sees the change once its buffer is used up, as with other shells, and never crashes the shell.
+///        The input is not inherited by child processes.
+class LineReader {
+public:
+
+    ~LineReader();
+
+    /// @brief Reads the next line, without its trailing newline.
+    ///
+    ///        Returns as soon as a whole line is available, so lines from a slow producer are not held back.
+    /// @param line Receives the line.
+    /// @return False if the end of the input, or a read error, is reached before any character is read. Otherwise, true.
+    bool readLine(std::string& line);
+
+    /// @brief Returns the buffered part of the input that was not read yet, reading more of the input first if none is.
+    ///
+    ///        Lets a caller scan many lines at once, such as a here-document body, instead of copying them one at a time.
+    ///        Nothing is read past the view until it is consumed.
+    /// @return Unread input, valid until the next call on the reader. Empty at the end of the input, or on a read error.
+    std::string_view peek();
+
+    /// @brief Marks the start of the view returned by peek as read.
+    /// @param count Number of characters read. At most the size of the view.
+    void consume(std::size_t count);
+
+    /// @brief Check if reading the input failed.
+    /// @return True if a read error occurred. Otherwise, false.
+    bool hasFailed() const;
+
+protected:
+private:
+    explicit LineReader(std::unique_ptr<detail::LineReaderHandle> lineReaderHandle);
+
+    std::unique_ptr<detail::LineReaderHandle> lineReaderHandle;
+    friend std::unique_ptr<LineReader> openLineReader(const std::string& path);
+    friend std::unique_ptr<LineReader> makeStandardInputLineReader();
+};
+
+} // namespace shelly::platform
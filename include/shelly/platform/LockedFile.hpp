@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace shelly::platform {
+
+class LockedFile;
+
+namespace detail {
+
+class LockedFileHandle;
+
+}
+
+/// @brief API function for locking a file against other processes that lock it, so they can update it in turn.
+///
+///        The lock is held on a companion file, "<path>.lock", created next to the file. Locking the file itself
+///        would not work, since replacing it gives it a new identity while others may wait for the old one.
+///        Blocks until the lock is acquired.
+/// @param path File path.
+/// @return New lock, or nullptr if the lock file could not be created or locked.
+std::unique_ptr<LockedFile> lockFile(const std::string& path);
+
+/// @brief Platform independent exclusive lock on a file, shared between processes. Released when destroyed.
+class LockedFile {
+public:
+
+    ~LockedFile();
+
+    /// @brief Reads contents of the locked file.
+    /// @return Optional that contains the file contents, empty if the file does not exist. No value on a read error.
+    std::optional<std::string> read() const;
+
+    /// @brief Replaces contents of the locked file atomically. Readers that do not lock the file see either
+    ///        the old or the new contents, never a part of them.
+    ///
+    ///        Contents are written to a uniquely named temporary file in the same directory, which is then renamed over the file.
+    /// @param contents New contents of the file.
+    /// @return True if the file was replaced.
+    bool replace(std::string_view contents);
+
+protected:
+private:
+    explicit LockedFile(std::unique_ptr<detail::LockedFileHandle> lockedFileHandle);
+
+    std::unique_ptr<detail::LockedFileHandle> lockedFileHandle;
+    friend std::unique_ptr<LockedFile> lockFile(const std::string& path);
+};
+
+} // namespace shelly::platform
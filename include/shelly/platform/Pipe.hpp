@@ -14,13 +14,18 @@ class PipeHandle;
 }
 
 /// @brief API function for creating pipes.
-/// @return New pipe.
+/// @return New pipe, or nullptr if the pipe could not be created.
 std::unique_ptr<Pipe> makePipe();
 
 /// @brief Platform indepentent pipe object.
+///
+///        Both ends are closed when the pipe is destroyed, so a reader sees the end of input only after
+///        every pipe object and process holding the input end is gone.
 class Pipe {
 public:
 
+    ~Pipe();
+
     /// @brief Returns pipe input file descriptor.
     /// @return Pipe input file descriptor.
     const FileDescriptor& getInputFileDescriptor() const;
@@ -32,7 +37,10 @@ public:
 
 protected:
 private:
+    explicit Pipe(std::unique_ptr<detail::PipeHandle> pipeHandle);
+
     std::unique_ptr<detail::PipeHandle> pipeHandle;
+    friend std::unique_ptr<Pipe> makePipe();
 };
 
-} // namespace shelly::platform
\ No newline at end of file
+} // namespace shelly::platform
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "FileDescriptor.hpp"
 #include "Pipe.hpp"
@@ -16,21 +21,58 @@ namespace detail {
     
 }
 
+/// @brief Resources used by a process, collected when the process is reaped.
+///
+///        Fields that the platform cannot report are left at zero.
+struct ProcessStatistics {
+    std::chrono::nanoseconds wallTime{0};       ///< Time from spawning the process until it exited.
+    std::chrono::microseconds userTime{0};      ///< CPU time spent in user mode.
+    std::chrono::microseconds systemTime{0};    ///< CPU time spent in kernel mode.
+    long maxResidentSetKilobytes = 0;           ///< Peak resident set size.
+    long voluntaryContextSwitches = 0;          ///< Context switches caused by blocking.
+    long involuntaryContextSwitches = 0;        ///< Context switches caused by preemption.
+    long minorPageFaults = 0;                   ///< Page faults served without I/O.
+    long majorPageFaults = 0;                   ///< Page faults that required I/O.
+};
+
+/// @brief API function for waiting on several processes, such as the stages of a pipeline.
+///
+///        Processes are reaped in the order they exit, so the wall time of each is accurate
+///        even when a later stage exits before an earlier one.
+/// @param processes Processes to wait for. Null entries are skipped.
+void waitForAll(std::span<Process* const> processes);
+
 /// @brief Platform indepentent process object.
 class Process {
 public:
+
+    ~Process();
+
+    /// @brief Waits for the process to exit. Subsequent calls return the same status without waiting.
+    /// @return Exit status of the process. If the process was terminated by a signal, 128 + signal number.
+    int wait();
+
+    /// @brief Returns resources used by the process.
+    /// @return Resources used by the process. All fields are zero until the process is waited for.
+    const ProcessStatistics& getStatistics() const;
+
 protected:
 private:
-    Process();
+    explicit Process(std::unique_ptr<detail::ProcessHandle> processHandle);
 
     std::unique_ptr<detail::ProcessHandle> processHandle;
     friend class ProcessBuilder;
+    friend void waitForAll(std::span<Process* const> processes);
 };
 
 /// @brief API builder class for creating processes.
 class ProcessBuilder {
 public:
 
+    /// @brief Instantiate a builder for a process running the given program.
+    /// @param arguments Process arguments. The first argument is the program name, which is searched for in PATH.
+    explicit ProcessBuilder(std::vector<std::string> arguments) : arguments(std::move(arguments)) {}
+
     /// @brief Redirects the process' output to the given output file descriptor.
     /// @param output Output file descriptor.
     /// @return Returns this process builder object.
@@ -41,13 +83,24 @@ public:
     /// @return Returns this process builder object.
     ProcessBuilder& redirectInput(const FileDescriptor& input);
 
+    /// @brief Redirects the process' error output to the given output file descriptor.
+    /// @param error Error output file descriptor.
+    /// @return Returns this process builder object.
+    ProcessBuilder& redirectError(const FileDescriptor& error);
+
     /// @brief Spawns the process and returns the process object.
-    /// @return Process object.
+    ///
+    ///        File descriptors passed to the redirect methods must stay open until this method returns.
+    /// @return Process object, or nullptr if the program could not be found or started.
     std::unique_ptr<Process> spawn();
 
 protected:
 private:
-    std::unique_ptr<Process> process;
+    std::vector<std::string> arguments;
+
+    FileDescriptor::NativeHandle input = FileDescriptor::invalidHandle;
+    FileDescriptor::NativeHandle output = FileDescriptor::invalidHandle;
+    FileDescriptor::NativeHandle error = FileDescriptor::invalidHandle;
 };
 
-} // namespace shelly::platform
\ No newline at end of file
+} // namespace shelly::platform
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace shelly::platform
+{
+
+/// @brief Check if the standard input of the shell is attached to a terminal.
+/// @return True if the standard input is a terminal. Otherwise, false.
+bool isStandardInputTerminal();
+
+} // namespace shelly::platform
@@ -1,12 +1,23 @@
-#include <iostream>
+#include <cstdio>
+#include <string_view>
 
 #include "shelly/core/Shell.hpp"
 
-int main(int, char**){
+int main(int argc, char** argv){
     shelly::core::Shell shell;
 
-    /// @todo Add logging.
-    std::cout << "Shelly starting..." << std::endl;
+    if (argc > 1 && std::string_view(argv[1]) == "-c") {
+        if (argc < 3) {
+            std::fputs("shelly: -c: option requires an argument\n", stderr);
+            return 2;
+        }
+        /// @todo Pass the remaining arguments as positional parameters.
+        return shell.runCommandString(argv[2]);
+    }
+
+    if (argc > 1) {
+        return shell.runScriptFile(argv[1]);
+    }
 
     return shell.run();
 }
@@ -1,6 +0,0 @@
-#include "shelly/ast/parser/Parser.hpp"
-
-namespace shelly::ast
-{
-    
-} // namespace shelly::ast
@@ -0,0 +1,57 @@
+#include "Builtins.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <utility>
+
+#include "shelly/core/Shell.hpp"
+
+namespace shelly::core
+{
+
+namespace {
+
+int builtinTrue(Shell&, const std::vector<std::string>&) {
+    return 0;
+}
+
+int builtinFalse(Shell&, const std::vector<std::string>&) {
+    return 1;
+}
+
+int builtinExit(Shell& shell, const std::vector<std::string>& arguments) {
+    int exitStatus = shell.getLastExitStatus();
+
+    if (arguments.size() > 1) {
+        const std::string& argument = arguments[1];
+        auto [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), exitStatus);
+        if (error != std::errc() || end != argument.data() + argument.size() || exitStatus < 0) {
+            std::fprintf(stderr, "shelly: exit: illegal number: %s\n", argument.c_str());
+            return 2;
+        }
+    }
+
+    shell.requestExit(exitStatus & 0xFF);
+    return exitStatus & 0xFF;
+}
+
+constexpr std::array<std::pair<std::string_view, Builtin>, 4> builtins = {{
+    {":", builtinTrue},
+    {"true", builtinTrue},
+    {"false", builtinFalse},
+    {"exit", builtinExit},
+}};
+
+} // namespace
+
+Builtin findBuiltin(std::string_view name) {
+    for (const auto& [builtinName, builtin] : builtins) {
+        if (builtinName == name) {
+            return builtin;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace shelly::core
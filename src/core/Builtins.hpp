@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace shelly::core
+{
+
+class Shell;
+
+/// @brief Builtin command, executed inside the shell process without spawning a child.
+/// @param shell     Shell executing the builtin.
+/// @param arguments Command arguments, including the builtin name.
+/// @return Exit status of the builtin.
+using Builtin = int (*)(Shell& shell, const std::vector<std::string>& arguments);
+
+/// @brief Looks up a builtin command by name.
+/// @param name Program name of a command.
+/// @return The builtin, or nullptr if there is no builtin with the given name.
+Builtin findBuiltin(std::string_view name);
+
+} // namespace shelly::core
@@ -0,0 +1,321 @@
+#include "MetricsSink.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+
+#include "shelly/platform/LockedFile.hpp"
+
+namespace shelly::core
+{
+
+namespace {
+
+double toSeconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+/// @brief Escapes a string for a JSON string literal, or a Prometheus label value.
+std::string escape(std::string_view value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for (char c : value) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            case '\r': escaped += "\\r"; break;
+            default: {
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+                break;
+            }
+        }
+    }
+
+    return escaped;
+}
+
+/// @brief Reads a label value escaped by escape() from the front of the input, up to and including its closing quote.
+/// @return Optional that contains the unescaped value, or no value if the input ends before the closing quote.
+std::optional<std::string> takeEscapedValue(std::string_view& input) {
+    std::string value;
+
+    while (!input.empty()) {
+        char c = input.front();
+        input.remove_prefix(1);
+        if (c == '"') {
+            return value;
+        }
+        if (c != '\\' || input.empty()) {
+            value += c;
+            continue;
+        }
+
+        char escaped = input.front();
+        input.remove_prefix(1);
+        switch (escaped) {
+            case 'n': value += '\n'; break;
+            case 't': value += '\t'; break;
+            case 'r': value += '\r'; break;
+            case 'u': {
+                if (input.size() < 4) {
+                    return std::nullopt;
+                }
+                value += static_cast<char>(std::strtol(std::string(input.substr(0, 4)).c_str(), nullptr, 16));
+                input.remove_prefix(4);
+                break;
+            }
+            default: value += escaped; break;
+        }
+    }
+
+    return std::nullopt;
+}
+
+} // namespace
+
+std::unique_ptr<MetricsSink> MetricsSink::fromEnvironment() {
+    const char* path = std::getenv("SHELLY_METRICS_FILE");
+    if (path == nullptr || *path == '\0') {
+        return nullptr;
+    }
+
+    Format format = Format::JsonLines;
+    const char* formatName = std::getenv("SHELLY_METRICS_FORMAT");
+    if (formatName != nullptr && std::string_view(formatName) == "prometheus") {
+        format = Format::PrometheusTextfile;
+    }
+
+    return std::make_unique<MetricsSink>(path, format);
+}
+
+void MetricsSink::record(const PipelineMetrics& metrics) {
+    switch (format) {
+        case Format::JsonLines: {
+            appendJsonLine(metrics);
+            break;
+        }
+        case Format::PrometheusTextfile: {
+            updatePrometheusTextfile(metrics);
+            break;
+        }
+    }
+}
+
+void MetricsSink::appendJsonLine(const PipelineMetrics& metrics) {
+    std::string line = "{\"timestamp\":";
+    line += std::to_string(toSeconds(metrics.startTime.time_since_epoch()));
+    line += ",\"command\":\"" + escape(metrics.commandLine) + "\"";
+    line += ",\"status\":" + std::to_string(metrics.exitStatus);
+    line += ",\"real_seconds\":" + std::to_string(toSeconds(metrics.wallTime));
+    line += ",\"stages\":[";
+
+    for (std::size_t i = 0; i < metrics.stages.size(); i++) {
+        const StageMetrics& stage = metrics.stages[i];
+        const platform::ProcessStatistics& statistics = stage.statistics;
+        if (i > 0) {
+            line += ",";
+        }
+        line += "{\"command\":\"" + escape(stage.commandLine) + "\"";
+        line += ",\"builtin\":" + std::string(stage.builtin ? "true" : "false");
+        line += ",\"status\":" + std::to_string(stage.exitStatus);
+        line += ",\"real_seconds\":" + std::to_string(toSeconds(statistics.wallTime));
+        line += ",\"user_seconds\":" + std::to_string(toSeconds(statistics.userTime));
+        line += ",\"sys_seconds\":" + std::to_string(toSeconds(statistics.systemTime));
+        line += ",\"max_rss_kb\":" + std::to_string(statistics.maxResidentSetKilobytes);
+        line += ",\"voluntary_context_switches\":" + std::to_string(statistics.voluntaryContextSwitches);
+        line += ",\"involuntary_context_switches\":" + std::to_string(statistics.involuntaryContextSwitches);
+        line += ",\"minor_page_faults\":" + std::to_string(statistics.minorPageFaults);
+        line += ",\"major_page_faults\":" + std::to_string(statistics.majorPageFaults);
+        line += "}";
+    }
+    line += "]}\n";
+
+    std::FILE* file = std::fopen(path.c_str(), "a");
+    if (file == nullptr) {
+        reportWriteError();
+        return;
+    }
+    bool written = std::fwrite(line.data(), 1, line.size(), file) == line.size();
+    if (std::fclose(file) != 0 || !written) {
+        reportWriteError();
+    }
+}
+
+void MetricsSink::updatePrometheusTextfile(const PipelineMetrics& metrics) {
+    /// @note The lock makes the read, the update and the replacement one step, so concurrent shells never lose each other's counts.
+    std::unique_ptr<platform::LockedFile> file = platform::lockFile(path);
+    if (!file) {
+        reportWriteError();
+        return;
+    }
+
+    std::optional<std::string> contents = file->read();
+    if (!contents.has_value()) {
+        reportWriteError();
+        return;
+    }
+
+    std::map<std::string, ProgramTotals> programTotals;
+    readPrometheusTextfile(*contents, programTotals);
+
+    for (const StageMetrics& stage : metrics.stages) {
+        ProgramTotals& totals = programTotals[stage.program];
+        const platform::ProcessStatistics& statistics = stage.statistics;
+        totals.runs++;
+        totals.failures += stage.exitStatus != 0;
+        totals.realSeconds += toSeconds(statistics.wallTime);
+        totals.userSeconds += toSeconds(statistics.userTime);
+        totals.systemSeconds += toSeconds(statistics.systemTime);
+        totals.maxResidentSetKilobytes = std::max(totals.maxResidentSetKilobytes, statistics.maxResidentSetKilobytes);
+        totals.voluntaryContextSwitches += statistics.voluntaryContextSwitches;
+        totals.involuntaryContextSwitches += statistics.involuntaryContextSwitches;
+        totals.minorPageFaults += statistics.minorPageFaults;
+        totals.majorPageFaults += statistics.majorPageFaults;
+    }
+
+    /// @note The textfile collector may read the file at any time, so it is replaced atomically.
+    if (!file->replace(formatPrometheusTextfile(programTotals))) {
+        reportWriteError();
+    }
+}
+
+void MetricsSink::readPrometheusTextfile(std::string_view contents, std::map<std::string, ProgramTotals>& programTotals) {
+    while (!contents.empty()) {
+        std::size_t lineEnd = contents.find('\n');
+        std::string_view line = contents.substr(0, lineEnd);
+        contents.remove_prefix(lineEnd == std::string_view::npos ? contents.size() : lineEnd + 1);
+
+        /// @note Samples have the form: name{program="..."[,label="..."]} value
+        std::size_t nameEnd = line.find('{');
+        if (line.empty() || line.front() == '#' || nameEnd == std::string_view::npos) {
+            continue;
+        }
+        std::string_view name = line.substr(0, nameEnd);
+        line.remove_prefix(nameEnd + 1);
+
+        constexpr std::string_view programLabel = "program=\"";
+        if (!line.starts_with(programLabel)) {
+            continue;
+        }
+        line.remove_prefix(programLabel.size());
+        std::optional<std::string> program = takeEscapedValue(line);
+        if (!program.has_value()) {
+            continue;
+        }
+
+        std::optional<std::string> extraLabel;
+        if (line.starts_with(",")) {
+            std::size_t valueStart = line.find("=\"");
+            if (valueStart == std::string_view::npos) {
+                continue;
+            }
+            line.remove_prefix(valueStart + 2);
+            extraLabel = takeEscapedValue(line);
+            if (!extraLabel.has_value()) {
+                continue;
+            }
+        }
+        if (!line.starts_with("} ")) {
+            continue;
+        }
+        line.remove_prefix(2);
+        double value = std::strtod(std::string(line).c_str(), nullptr);
+        long count = std::lround(value);
+
+        ProgramTotals& totals = programTotals[*program];
+        std::string_view label = extraLabel.value_or("");
+        if (name == "shelly_command_runs_total") {
+            totals.runs += count;
+        } else if (name == "shelly_command_failures_total") {
+            totals.failures += count;
+        } else if (name == "shelly_command_real_seconds_total") {
+            totals.realSeconds += value;
+        } else if (name == "shelly_command_cpu_seconds_total" && label == "user") {
+            totals.userSeconds += value;
+        } else if (name == "shelly_command_cpu_seconds_total" && label == "system") {
+            totals.systemSeconds += value;
+        } else if (name == "shelly_command_max_rss_bytes") {
+            totals.maxResidentSetKilobytes = std::max(totals.maxResidentSetKilobytes, std::lround(value / 1024));
+        } else if (name == "shelly_command_context_switches_total" && label == "voluntary") {
+            totals.voluntaryContextSwitches += count;
+        } else if (name == "shelly_command_context_switches_total" && label == "involuntary") {
+            totals.involuntaryContextSwitches += count;
+        } else if (name == "shelly_command_page_faults_total" && label == "minor") {
+            totals.minorPageFaults += count;
+        } else if (name == "shelly_command_page_faults_total" && label == "major") {
+            totals.majorPageFaults += count;
+        }
+    }
+}
+
+std::string MetricsSink::formatPrometheusTextfile(const std::map<std::string, ProgramTotals>& programTotals) {
+    struct Metric {
+        const char* name;
+        const char* type;
+        const char* help;
+    };
+
+    std::string contents;
+    auto writeHeader = [&contents](const Metric& metric) {
+        contents += std::string("# HELP ") + metric.name + " " + metric.help + "\n";
+        contents += std::string("# TYPE ") + metric.name + " " + metric.type + "\n";
+    };
+    auto writeSample = [&contents](const Metric& metric, const std::string& program, const char* extraLabel, double value) {
+        contents += std::string(metric.name) + "{program=\"" + escape(program) + "\"" + extraLabel + "} " + std::to_string(value) + "\n";
+    };
+
+    const Metric runs{"shelly_command_runs_total", "counter", "Commands executed by the shell."};
+    const Metric failures{"shelly_command_failures_total", "counter", "Commands that exited with a non-zero status."};
+    const Metric realSeconds{"shelly_command_real_seconds_total", "counter", "Wall time of commands."};
+    const Metric cpuSeconds{"shelly_command_cpu_seconds_total", "counter", "CPU time of commands."};
+    const Metric maxResidentSet{"shelly_command_max_rss_bytes", "gauge", "Largest peak resident set size of a command."};
+    const Metric contextSwitches{"shelly_command_context_switches_total", "counter", "Context switches of commands."};
+    const Metric pageFaults{"shelly_command_page_faults_total", "counter", "Page faults of commands."};
+
+    writeHeader(runs);
+    for (const auto& [program, totals] : programTotals) { writeSample(runs, program, "", totals.runs); }
+    writeHeader(failures);
+    for (const auto& [program, totals] : programTotals) { writeSample(failures, program, "", totals.failures); }
+    writeHeader(realSeconds);
+    for (const auto& [program, totals] : programTotals) { writeSample(realSeconds, program, "", totals.realSeconds); }
+    writeHeader(cpuSeconds);
+    for (const auto& [program, totals] : programTotals) {
+        writeSample(cpuSeconds, program, ",mode=\"user\"", totals.userSeconds);
+        writeSample(cpuSeconds, program, ",mode=\"system\"", totals.systemSeconds);
+    }
+    writeHeader(maxResidentSet);
+    for (const auto& [program, totals] : programTotals) { writeSample(maxResidentSet, program, "", totals.maxResidentSetKilobytes * 1024.0); }
+    writeHeader(contextSwitches);
+    for (const auto& [program, totals] : programTotals) {
+        writeSample(contextSwitches, program, ",kind=\"voluntary\"", totals.voluntaryContextSwitches);
+        writeSample(contextSwitches, program, ",kind=\"involuntary\"", totals.involuntaryContextSwitches);
+    }
+    writeHeader(pageFaults);
+    for (const auto& [program, totals] : programTotals) {
+        writeSample(pageFaults, program, ",kind=\"minor\"", totals.minorPageFaults);
+        writeSample(pageFaults, program, ",kind=\"major\"", totals.majorPageFaults);
+    }
+
+    return contents;
+}
+
+void MetricsSink::reportWriteError() {
+    if (!writeErrorReported) {
+        std::fprintf(stderr, "shelly: cannot write metrics to %s\n", path.c_str());
+        writeErrorReported = true;
+    }
+}
+
+} // namespace shelly::core
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "PipelineMetrics.hpp"
+
+namespace shelly::core
+{
+
+/// @brief Shell-wide destination for the resource usage of every executed pipeline.
+///
+///        Configured with environment variables:
+///        - SHELLY_METRICS_FILE   - path of the metrics file. The sink is disabled if it is unset or empty.
+///        - SHELLY_METRICS_FORMAT - "jsonl" (default) appends one JSON record per pipeline.
+///                                  "prometheus" keeps per-program totals in a Prometheus textfile.
+///
+///        Every shell using the same textfile adds to the totals already in it, under a lock, so the counters
+///        keep growing across `sh -c` invocations and concurrent shells.
+/// @todo Move the configuration to the config class, once it exists.
+class MetricsSink {
+public:
+
+    /// @brief Format of the metrics file.
+    enum class Format {
+        JsonLines,          ///< One JSON object per executed pipeline, appended to the file.
+        PrometheusTextfile, ///< Per-program counters, for the node_exporter textfile collector.
+    };
+
+    /// @brief Instantiate a sink writing to the given file.
+    /// @param path   Metrics file path.
+    /// @param format Metrics file format.
+    MetricsSink(std::string path, Format format) : path(std::move(path)), format(format) {}
+
+    /// @brief Instantiate a sink configured by the environment.
+    /// @return Metrics sink, or nullptr if no metrics file is configured.
+    static std::unique_ptr<MetricsSink> fromEnvironment();
+
+    /// @brief Writes the resource usage of an executed pipeline to the metrics file.
+    /// @param metrics Resource usage of the pipeline.
+    void record(const PipelineMetrics& metrics);
+
+protected:
+private:
+
+    /// @brief Running totals of all commands with the same program name.
+    struct ProgramTotals {
+        long runs = 0;
+        long failures = 0;
+        double realSeconds = 0;
+        double userSeconds = 0;
+        double systemSeconds = 0;
+        long maxResidentSetKilobytes = 0;
+        long voluntaryContextSwitches = 0;
+        long involuntaryContextSwitches = 0;
+        long minorPageFaults = 0;
+        long majorPageFaults = 0;
+    };
+
+    std::string path;
+    Format format;
+    bool writeErrorReported = false;
+
+    void appendJsonLine(const PipelineMetrics& metrics);
+    void updatePrometheusTextfile(const PipelineMetrics& metrics);
+    void reportWriteError();
+
+    /// @brief Adds totals found in a Prometheus textfile written by a sink. Unknown samples are ignored.
+    static void readPrometheusTextfile(std::string_view contents, std::map<std::string, ProgramTotals>& programTotals);
+    static std::string formatPrometheusTextfile(const std::map<std::string, ProgramTotals>& programTotals);
+
+};
+
+} // namespace shelly::core
@@ -0,0 +1,48 @@
+#include "PipelineMetrics.hpp"
+
+namespace shelly::core
+{
+
+namespace {
+
+double toSeconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+void writeTimeReport(std::FILE* stream, const PipelineMetrics& metrics) {
+    std::chrono::microseconds userTime{0};
+    std::chrono::microseconds systemTime{0};
+    for (const StageMetrics& stage : metrics.stages) {
+        userTime += stage.statistics.userTime;
+        systemTime += stage.statistics.systemTime;
+    }
+
+    std::fprintf(stream, "real\t%.3fs\nuser\t%.3fs\nsys\t%.3fs\n", toSeconds(metrics.wallTime), toSeconds(userTime), toSeconds(systemTime));
+
+    if (metrics.stages.empty()) {
+        return;
+    }
+
+    std::fprintf(stream, "stage\treal\tuser\tsys\tmaxrss\tcsw(v/i)\tflt(min/maj)\tstatus\tcommand\n");
+    for (std::size_t i = 0; i < metrics.stages.size(); i++) {
+        const StageMetrics& stage = metrics.stages[i];
+        const platform::ProcessStatistics& statistics = stage.statistics;
+        std::fprintf(stream, "%zu\t%.3fs\t%.3fs\t%.3fs\t%ldkB\t%ld/%ld\t%ld/%ld\t%d\t%s%s\n",
+            i + 1,
+            toSeconds(statistics.wallTime),
+            toSeconds(statistics.userTime),
+            toSeconds(statistics.systemTime),
+            statistics.maxResidentSetKilobytes,
+            statistics.voluntaryContextSwitches,
+            statistics.involuntaryContextSwitches,
+            statistics.minorPageFaults,
+            statistics.majorPageFaults,
+            stage.exitStatus,
+            stage.commandLine.c_str(),
+            stage.builtin ? " (builtin)" : "");
+    }
+}
+
+} // namespace shelly::core
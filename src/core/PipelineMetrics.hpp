@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "shelly/platform/Process.hpp"
+
+namespace shelly::core
+{
+
+/// @brief Resource usage of a single command of an executed pipeline.
+struct StageMetrics {
+    std::string program;                    ///< Program name of the command.
+    std::string commandLine;                ///< Command arguments, joined with spaces.
+    int exitStatus = 0;
+    bool builtin = false;                   ///< Builtins run inside the shell, so only their wall time is measured.
+    platform::ProcessStatistics statistics;
+};
+
+/// @brief Resource usage of an executed pipeline.
+struct PipelineMetrics {
+    std::string commandLine;                ///< Commands of the pipeline, joined with " | ".
+    int exitStatus = 0;
+    std::chrono::nanoseconds wallTime{0};   ///< Time from spawning the first command until the last one was reaped.
+    std::chrono::system_clock::time_point startTime;
+    std::vector<StageMetrics> stages;
+};
+
+/// @brief Writes the report of the time keyword: totals of the pipeline, followed by one line per command.
+/// @param stream  Stream the report is written to.
+/// @param metrics Resource usage of the pipeline.
+void writeTimeReport(std::FILE* stream, const PipelineMetrics& metrics);
+
+} // namespace shelly::core
@@ -1,12 +1,614 @@
 #include "shelly/core/Shell.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Builtins.hpp"
+#include "MetricsSink.hpp"
+#include "PipelineMetrics.hpp"
+#include "shelly/ast/parser/CompiledScript.hpp"
+#include "shelly/ast/parser/Parser.hpp"
+#include "shelly/core/DefaultRcScript.hpp"
+#include "shelly/platform/FileDescriptor.hpp"
+#include "shelly/platform/HereDocument.hpp"
+#include "shelly/platform/IOEngine.hpp"
+#include "shelly/platform/LineReader.hpp"
+#include "shelly/platform/Pipe.hpp"
+#include "shelly/platform/Process.hpp"
+#include "shelly/platform/Terminal.hpp"
+
 namespace shelly::core {
 
-Shell::Shell() {}
+namespace {
+
+/// @brief Default rc script, lexed and parsed at compile time so startup does no parsing of built-in configuration.
+constexpr auto compiledDefaultRcScript = ast::compileScript<defaultRcScript>();
+
+/// @brief Exit status of a command that failed before it could run.
+constexpr int generalErrorStatus = 1;
+
+/// @brief Exit status of a pipeline whose program could not be found or started.
+constexpr int commandNotFoundStatus = 127;
+
+/// @brief Exit status of a malformed command.
+constexpr int syntaxErrorStatus = 2;
+
+/// @brief Rebuilds a pipeline of the compiled default rc script, so it can be executed like any other pipeline.
+ast::PipelineASTNode toPipelineASTNode(const ast::CompiledPipeline& compiledPipeline) {
+    ast::PipelineASTNode pipeline;
+    pipeline.setTimed(compiledPipeline.timed);
+
+    for (const ast::CompiledCommand& compiledCommand : compiledDefaultRcScript.getCommands(compiledPipeline)) {
+        ast::CommandASTNode command;
+        for (std::size_t i = 0; i < compiledCommand.argumentCount; i++) {
+            command.addArgument(compiledDefaultRcScript.getArgument(compiledCommand, i));
+        }
+        if (auto input = compiledDefaultRcScript.getRedirection(compiledCommand.inputRedirection)) {
+            command.setInputRedirection(*input);
+        }
+        if (auto output = compiledDefaultRcScript.getRedirection(compiledCommand.outputRedirection)) {
+            command.setOutputRedirection(*output);
+        }
+        if (auto error = compiledDefaultRcScript.getRedirection(compiledCommand.errorRedirection)) {
+            command.setErrorRedirection(*error);
+        }
+        pipeline.addCommand(std::move(command));
+    }
+
+    return pipeline;
+}
+
+/// @brief Delimiter of a here-document, found in a line of input.
+struct HereDocumentDelimiter {
+    std::size_t command;        ///< Index of the command inside the pipeline.
+    std::string_view word;
+    bool stripTabs;
+};
+
+/// @brief Finds delimiters of all here-documents in a line, in the order their bodies follow the line.
+///
+///        A command may have several here-documents. Only the last one is its input, but bodies of all of them follow the line.
+/// @param line Well formed line of input.
+/// @return Delimiters of here-documents in the line.
+std::vector<HereDocumentDelimiter> findHereDocumentDelimiters(std::string_view line) {
+    std::vector<HereDocumentDelimiter> delimiters;
+    if (line.find("<<") == std::string_view::npos) {
+        return delimiters;
+    }
+
+    ast::Lexer lexer(line);
+    std::size_t command = 0;
+    while (lexer.hasTokensLeft()) {
+        ast::Token token = lexer.consume().value();
+        if (token.is(ast::TokenKind::PIPE)) {
+            command++;
+            continue;
+        }
+
+        bool stripTabs = token.is(ast::TokenKind::HERE_DOCUMENT_STRIP_TABS);
+        if (!token.is(ast::TokenKind::HERE_DOCUMENT) && !stripTabs) {
+            continue;
+        }
+        std::optional<ast::Token> word = lexer.consume();
+        if (word.has_value() && word->isStringLiteral()) {
+            delimiters.push_back(HereDocumentDelimiter{command, word->getData(), stripTabs});
+        }
+    }
+
+    return delimiters;
+}
+
+/// @brief Check if a line of input ends a here-document body.
+bool isDelimiterLine(std::string_view line, const HereDocumentDelimiter& delimiter) {
+    if (delimiter.stripTabs) {
+        line.remove_prefix(std::min(line.find_first_not_of('\t'), line.size()));
+    }
+    return line == delimiter.word;
+}
+
+/// @brief Splits a here-document body off the front of the input.
+/// @param input      Input that follows a line. Advanced past the delimiter line.
+/// @param delimiter  Delimiter of the here-document.
+/// @param lineNumber Advanced past the body and the delimiter line.
+/// @param delimited  Set to false if the input ended before the delimiter line. Then, the rest of the input is the body.
+/// @return Body lines, without the delimiter line.
+std::string_view takeHereDocumentBody(std::string_view& input, const HereDocumentDelimiter& delimiter, std::size_t& lineNumber, bool& delimited) {
+    std::string_view body = input;
+    std::size_t bodySize = 0;
+
+    while (!input.empty()) {
+        std::size_t lineEnd = input.find('\n');
+        std::size_t lineSize = lineEnd == std::string_view::npos ? input.size() : lineEnd + 1;
+        std::string_view line = input.substr(0, lineEnd);
+        input.remove_prefix(lineSize);
+        lineNumber++;
+
+        if (isDelimiterLine(line, delimiter)) {
+            delimited = true;
+            return body.substr(0, bodySize);
+        }
+        bodySize += lineSize;
+    }
+
+    delimited = false;
+    return body;
+}
+
+/// @brief Reads bodies of the line's here-documents from the input, up to and including their delimiter lines.
+/// @param line        Line whose here-documents are read.
+/// @param input       Input the line was read from.
+/// @param interactive True if every body line is prompted for.
+/// @return Lines read, each followed by a newline.
+std::string readHereDocumentLines(std::string_view line, platform::LineReader& input, bool interactive) {
+    std::string lines;
+    std::size_t lineStart = 0;
+
+    /// @note Whole buffers of the input are scanned for the delimiter line, and only the input up to and including it
+    ///       is consumed, so the lines that follow stay in the reader.
+    for (const HereDocumentDelimiter& delimiter : findHereDocumentDelimiters(line)) {
+        bool delimited = false;
+        while (!delimited) {
+            if (interactive && lineStart == lines.size()) {
+                std::fputs("> ", stderr);
+            }
+            std::string_view unread = input.peek();
+            if (unread.empty()) {
+                if (lineStart != lines.size()) {
+                    lines += '\n';
+                }
+                return lines;
+            }
+            std::size_t unreadStart = lines.size();
+            lines += unread;
+
+            std::size_t lineEnd;
+            while (!delimited && (lineEnd = lines.find('\n', lineStart)) != std::string::npos) {
+                delimited = isDelimiterLine(std::string_view(lines).substr(lineStart, lineEnd - lineStart), delimiter);
+                lineStart = lineEnd + 1;
+            }
+            if (delimited) {
+                input.consume(lineStart - unreadStart);
+                lines.resize(lineStart);
+            } else {
+                input.consume(unread.size());
+            }
+        }
+    }
+
+    return lines;
+}
+
+/// @brief Creates the input of a command from its here-document.
+/// @param hereDocument Here-document of the command, with its body attached.
+/// @return Input for the command, or nullptr if it could not be created.
+std::unique_ptr<platform::FileDescriptor> makeHereDocumentInput(const ast::HereDocument& hereDocument) {
+    switch (hereDocument.kind) {
+        case ast::HereDocument::Kind::String: {
+            std::string_view body[] = {hereDocument.word, "\n"};
+            return platform::makeHereDocumentInput(body);
+        }
+        case ast::HereDocument::Kind::Document: {
+            return platform::makeHereDocumentInput(std::span<const std::string_view>(&hereDocument.body, 1));
+        }
+        case ast::HereDocument::Kind::DocumentStripTabs: {
+            /// @note Stripped lines are still views into the input, so the body is never copied by the shell.
+            std::vector<std::string_view> lines;
+            std::string_view body = hereDocument.body;
+            while (!body.empty()) {
+                std::size_t lineEnd = body.find('\n');
+                std::size_t lineSize = lineEnd == std::string_view::npos ? body.size() : lineEnd + 1;
+                std::string_view bodyLine = body.substr(0, lineSize);
+                bodyLine.remove_prefix(std::min(bodyLine.find_first_not_of('\t'), bodyLine.size()));
+                lines.push_back(bodyLine);
+                body.remove_prefix(lineSize);
+            }
+            return platform::makeHereDocumentInput(lines);
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+Shell::Shell() : metricsSink(MetricsSink::fromEnvironment()) {}
+
+Shell::~Shell() = default;
 
 int Shell::run() {
+    std::unique_ptr<platform::LineReader> input = platform::makeStandardInputLineReader();
+    if (!input) {
+        std::fputs("shelly: cannot read standard input\n", stderr);
+        return syntaxErrorStatus;
+    }
+
+    bool interactive = platform::isStandardInputTerminal();
+    if (interactive) {
+        initializeInteractive();
+    }
+
+    int exitStatus = runLines(*input, interactive);
+    if (!interactive && input->hasFailed()) {
+        std::fputs("shelly: cannot read standard input\n", stderr);
+        return syntaxErrorStatus;
+    }
+    return exitStatus;
+}
+
+int Shell::runCommandString(std::string_view commandString) {
+    return runScript(commandString);
+}
+
+int Shell::runScriptFile(const std::string& path) {
+    std::unique_ptr<platform::LineReader> script = platform::openLineReader(path);
+    if (!script) {
+        std::fprintf(stderr, "shelly: cannot open %s\n", path.c_str());
+        return commandNotFoundStatus;
+    }
+
+    int exitStatus = runLines(*script, false);
+    if (script->hasFailed()) {
+        std::fprintf(stderr, "shelly: cannot read %s\n", path.c_str());
+        return syntaxErrorStatus;
+    }
+    return exitStatus;
+}
+
+platform::IOEngine& Shell::getIOEngine() {
+    if (!ioEngine) {
+        ioEngine = platform::makeIOEngine();
+    }
+    return *ioEngine;
+}
+
+void Shell::requestExit(int exitStatus) {
+    lastExitStatus = exitStatus;
+    exitRequested = true;
+}
+
+void Shell::initializeInteractive() {
+    /// @todo Add logging.
+    std::fputs("Shelly starting...\n", stdout);
+    std::fflush(stdout);
+
+    for (const ast::CompiledPipeline& pipeline : compiledDefaultRcScript.getPipelines()) {
+        lastExitStatus = executePipeline(toPipelineASTNode(pipeline));
+        if (exitRequested) {
+            return;
+        }
+    }
+}
+
+int Shell::runLines(platform::LineReader& input, bool interactive) {
+    std::string line;
+    std::size_t lineNumber = 0;
+
+    while (!exitRequested) {
+        if (interactive) {
+            std::fputs("shelly$ ", stderr);
+        }
+        if (!input.readLine(line)) {
+            break;
+        }
+        std::string hereDocumentLines = readHereDocumentLines(line, input, interactive);
+        std::string_view hereDocumentInput = hereDocumentLines;
+        lineNumber++;
+        if (!executeLine(line, lineNumber, hereDocumentInput) && !interactive) {
+            return syntaxErrorStatus;
+        }
+    }
+
+    return lastExitStatus;
+}
+
+int Shell::runScript(std::string_view script) {
+    std::size_t lineNumber = 0;
+
+    while (!script.empty() && !exitRequested) {
+        std::size_t lineEnd = script.find('\n');
+        std::string_view line = script.substr(0, lineEnd);
+        script.remove_prefix(lineEnd == std::string_view::npos ? script.size() : lineEnd + 1);
+
+        lineNumber++;
+        if (!executeLine(line, lineNumber, script)) {
+            return syntaxErrorStatus;
+        }
+    }
+
+    return lastExitStatus;
+}
+
+bool Shell::executeLine(std::string_view line, std::size_t& lineNumber, std::string_view& input) {
+    if (ast::isBlankOrCommentLine(line)) {
+        return true;
+    }
+
+    ast::Lexer lexer(line);
+    std::optional<ast::PipelineASTNode> pipeline = ast::Parser(lexer).parse();
+    if (!pipeline.has_value()) {
+        std::fprintf(stderr, "shelly: line %zu: syntax error\n", lineNumber);
+        lastExitStatus = syntaxErrorStatus;
+        return false;
+    }
+
+    std::size_t commandLineNumber = lineNumber;
+    for (const HereDocumentDelimiter& delimiter : findHereDocumentDelimiters(line)) {
+        bool delimited;
+        std::string_view body = takeHereDocumentBody(input, delimiter, lineNumber, delimited);
+        if (!delimited) {
+            std::fprintf(stderr, "shelly: line %zu: here-document delimited by end of file (wanted '%.*s')\n",
+                commandLineNumber, static_cast<int>(delimiter.word.size()), delimiter.word.data());
+        }
+
+        /// @note Bodies of here-documents replaced by a later input redirection are consumed, but not used.
+        ast::CommandASTNode& command = pipeline->getCommands()[delimiter.command];
+        if (command.getHereDocument() && command.getHereDocument()->isDelimited()) {
+            command.setHereDocumentBody(body);
+        }
+    }
+
+    lastExitStatus = executePipeline(*pipeline);
+    return true;
+}
+
+int Shell::executePipeline(const ast::PipelineASTNode& pipeline) {
+    if (!pipeline.isTimed() && !metricsSink) {
+        return executeCommands(pipeline, nullptr);
+    }
+
+    PipelineMetrics metrics;
+    metrics.startTime = std::chrono::system_clock::now();
+    auto start = std::chrono::steady_clock::now();
+
+    metrics.exitStatus = executeCommands(pipeline, &metrics);
+
+    metrics.wallTime = std::chrono::steady_clock::now() - start;
+    for (const StageMetrics& stage : metrics.stages) {
+        if (!metrics.commandLine.empty()) {
+            metrics.commandLine += " | ";
+        }
+        metrics.commandLine += stage.commandLine;
+    }
+
+    if (pipeline.isTimed()) {
+        writeTimeReport(stderr, metrics);
+    }
+    if (metricsSink && !metrics.stages.empty()) {
+        metricsSink->record(metrics);
+    }
+
+    return metrics.exitStatus;
+}
+
+int Shell::executeCommands(const ast::PipelineASTNode& pipeline, PipelineMetrics* metrics) {
+    const std::vector<ast::CommandASTNode>& commands = pipeline.getCommands();
+    if (commands.empty()) {
+        return lastExitStatus;
+    }
+
+    if (metrics) {
+        metrics->stages.resize(commands.size());
+        for (std::size_t i = 0; i < commands.size(); i++) {
+            const std::vector<std::string>& arguments = commands[i].getArguments();
+            metrics->stages[i].program = arguments.front();
+            for (const std::string& argument : arguments) {
+                if (!metrics->stages[i].commandLine.empty()) {
+                    metrics->stages[i].commandLine += ' ';
+                }
+                metrics->stages[i].commandLine += argument;
+            }
+        }
+    }
+
+    /// @note Builtins run inside the shell, so only their wall time is measured.
+    auto runBuiltin = [this, metrics](Builtin builtin, const ast::CommandASTNode& command, std::size_t stage) {
+        auto start = std::chrono::steady_clock::now();
+        int exitStatus = builtin(*this, command.getArguments());
+        if (metrics) {
+            metrics->stages[stage].builtin = true;
+            metrics->stages[stage].exitStatus = exitStatus;
+            metrics->stages[stage].statistics.wallTime = std::chrono::steady_clock::now() - start;
+        }
+        return exitStatus;
+    };
+
+    /// @note Redirection targets of all stages are opened in one batch before anything is spawned,
+    ///       so an io_uring engine, if one is requested, opens them with a single system call. Targets of builtins are opened too:
+    ///       the current builtins produce no output, but `: > file` still creates the file.
+    constexpr std::size_t noRedirection = SIZE_MAX;
+    struct StageRedirections {
+        std::size_t input = noRedirection;
+        std::size_t output = noRedirection;
+        std::size_t error = noRedirection;
+    };
+    std::vector<StageRedirections> stageRedirections;
+    std::vector<platform::IORequest> redirections;
+
+    for (std::size_t i = 0; i < commands.size(); i++) {
+        const ast::CommandASTNode& command = commands[i];
+        if (!command.getInputRedirection() && !command.getOutputRedirection() && !command.getErrorRedirection()) {
+            continue;
+        }
+        /// @note Pipelines without redirections, like a lone builtin, allocate nothing here.
+        if (stageRedirections.empty()) {
+            stageRedirections.resize(commands.size());
+        }
+        if (command.getInputRedirection()) {
+            stageRedirections[i].input = redirections.size();
+            redirections.push_back(platform::IORequest::openForReading(*command.getInputRedirection()));
+        }
+        if (command.getOutputRedirection()) {
+            stageRedirections[i].output = redirections.size();
+            redirections.push_back(platform::IORequest::openForWriting(*command.getOutputRedirection()));
+        }
+        if (command.getErrorRedirection()) {
+            stageRedirections[i].error = redirections.size();
+            redirections.push_back(platform::IORequest::openForWriting(*command.getErrorRedirection()));
+        }
+    }
+    if (!redirections.empty()) {
+        getIOEngine().submit(redirections);
+    }
+
+    auto getStageRedirections = [&stageRedirections](std::size_t stage) {
+        return stageRedirections.empty() ? StageRedirections{} : stageRedirections[stage];
+    };
+    auto openedRedirection = [&redirections](std::size_t index) -> const platform::FileDescriptor* {
+        return index == noRedirection ? nullptr : redirections[index].openedFile.get();
+    };
+
+    /// @note Reports redirection targets of the stage that could not be opened, and returns false if there are any.
+    auto checkRedirectionsOpened = [&](std::size_t stage) {
+        const ast::CommandASTNode& command = commands[stage];
+        StageRedirections indices = getStageRedirections(stage);
+        bool opened = true;
+
+        if (command.getInputRedirection() && !openedRedirection(indices.input)) {
+            std::fprintf(stderr, "shelly: cannot open %s\n", command.getInputRedirection()->c_str());
+            opened = false;
+        }
+        if (command.getOutputRedirection() && !openedRedirection(indices.output)) {
+            std::fprintf(stderr, "shelly: cannot create %s\n", command.getOutputRedirection()->c_str());
+            opened = false;
+        }
+        if (command.getErrorRedirection() && !openedRedirection(indices.error)) {
+            std::fprintf(stderr, "shelly: cannot create %s\n", command.getErrorRedirection()->c_str());
+            opened = false;
+        }
+        return opened;
+    };
+
+    /// @note A builtin whose redirection target cannot be opened does not run, and fails with status 1.
+    auto runBuiltinStage = [&](Builtin builtin, std::size_t stage) {
+        if (!checkRedirectionsOpened(stage)) {
+            if (metrics) {
+                metrics->stages[stage].builtin = true;
+                metrics->stages[stage].exitStatus = generalErrorStatus;
+            }
+            return generalErrorStatus;
+        }
+        return runBuiltin(builtin, commands[stage], stage);
+    };
+
+    /// @note Builtins that are the only command of a pipeline run inside the shell, so they can affect it.
+    if (commands.size() == 1) {
+        if (Builtin builtin = findBuiltin(commands.front().getArguments().front())) {
+            return runBuiltinStage(builtin, 0);
+        }
+    }
+
+    std::vector<std::unique_ptr<platform::Process>> processes;
+    std::vector<int> exitStatuses(commands.size(), 0);
+    std::unique_ptr<platform::Pipe> previousPipe;
+
+    for (std::size_t i = 0; i < commands.size(); i++) {
+        const ast::CommandASTNode& command = commands[i];
+
+        std::unique_ptr<platform::Pipe> nextPipe;
+        if (i + 1 < commands.size()) {
+            nextPipe = platform::makePipe();
+            if (!nextPipe) {
+                std::fputs("shelly: cannot create pipe\n", stderr);
+                exitStatuses.back() = generalErrorStatus;
+                break;
+            }
+        }
+
+        /// @note Builtins inside a multi-command pipeline run as if in a subshell: exit does not end the shell.
+        if (Builtin builtin = findBuiltin(command.getArguments().front())) {
+            bool wasExitRequested = exitRequested;
+            int savedExitStatus = lastExitStatus;
+            exitStatuses[i] = runBuiltinStage(builtin, i);
+            exitRequested = wasExitRequested;
+            lastExitStatus = savedExitStatus;
+            processes.push_back(nullptr);
+            previousPipe = std::move(nextPipe);
+            continue;
+        }
+
+        platform::ProcessBuilder processBuilder(command.getArguments());
+
+        if (previousPipe) {
+            processBuilder.redirectInput(previousPipe->getOutputFileDescriptor());
+        }
+        if (nextPipe) {
+            processBuilder.redirectOutput(nextPipe->getInputFileDescriptor());
+        }
+
+        StageRedirections indices = getStageRedirections(i);
+        const platform::FileDescriptor* input = openedRedirection(indices.input);
+        const platform::FileDescriptor* output = openedRedirection(indices.output);
+        const platform::FileDescriptor* error = openedRedirection(indices.error);
+        bool redirectionsOpened = checkRedirectionsOpened(i);
+
+        /// @note Here-document inputs are created right before the spawn, so at most one is held open at a time.
+        std::unique_ptr<platform::FileDescriptor> hereDocumentInput;
+        if (command.getHereDocument()) {
+            hereDocumentInput = makeHereDocumentInput(*command.getHereDocument());
+            if (!hereDocumentInput) {
+                std::fputs("shelly: cannot create here-document\n", stderr);
+            }
+        }
+
+        redirectionsOpened = redirectionsOpened && (hereDocumentInput || !command.getHereDocument());
+
+        if (input) {
+            processBuilder.redirectInput(*input);
+        }
+        if (hereDocumentInput) {
+            processBuilder.redirectInput(*hereDocumentInput);
+        }
+        if (output) {
+            processBuilder.redirectOutput(*output);
+        }
+        if (error) {
+            processBuilder.redirectError(*error);
+        }
+
+        std::unique_ptr<platform::Process> process;
+        if (redirectionsOpened) {
+            process = processBuilder.spawn();
+            if (!process) {
+                std::fprintf(stderr, "shelly: %s: not found\n", command.getArguments().front().c_str());
+                exitStatuses[i] = commandNotFoundStatus;
+            }
+        } else {
+            exitStatuses[i] = generalErrorStatus;
+        }
+
+        processes.push_back(std::move(process));
+
+        /// @note Dropping the previous pipe closes its ends in the shell, so readers see the end of input.
+        previousPipe = std::move(nextPipe);
+    }
+
+    previousPipe.reset();
+
+    std::vector<platform::Process*> pendingProcesses;
+    for (const std::unique_ptr<platform::Process>& process : processes) {
+        pendingProcesses.push_back(process.get());
+    }
+    platform::waitForAll(pendingProcesses);
+
+    for (std::size_t i = 0; i < processes.size(); i++) {
+        if (processes[i]) {
+            exitStatuses[i] = processes[i]->wait();
+            if (metrics) {
+                metrics->stages[i].statistics = processes[i]->getStatistics();
+            }
+        }
+        if (metrics) {
+            metrics->stages[i].exitStatus = exitStatuses[i];
+        }
+    }
 
-    return 0;
+    return exitStatuses.back();
 }
 
-} // namespace shelly::core
\ No newline at end of file
+} // namespace shelly::core
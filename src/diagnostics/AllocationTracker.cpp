@@ -0,0 +1,126 @@
+#include "shelly/diagnostics/AllocationTracker.hpp"
+
+#ifdef SHELLY_ALLOCATION_TRACKING
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace shelly::diagnostics
+{
+
+namespace {
+
+/// @note Counters are constant-initialized and never reset, so they are usable from operator new before main.
+///       Scopes remember the counters at their start, and report the difference.
+thread_local std::size_t allocationCount = 0;
+thread_local std::size_t deallocationCount = 0;
+thread_local std::size_t allocatedBytes = 0;
+
+} // namespace
+
+bool isAllocationTrackingEnabled() {
+#ifdef SHELLY_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationScope::AllocationScope() :
+    allocationCountAtStart(allocationCount),
+    deallocationCountAtStart(deallocationCount),
+    allocatedBytesAtStart(allocatedBytes)
+{}
+
+std::size_t AllocationScope::getAllocationCount() const {
+    return allocationCount - allocationCountAtStart;
+}
+
+std::size_t AllocationScope::getDeallocationCount() const {
+    return deallocationCount - deallocationCountAtStart;
+}
+
+std::size_t AllocationScope::getAllocatedBytes() const {
+    return allocatedBytes - allocatedBytesAtStart;
+}
+
+} // namespace shelly::diagnostics
+
+#ifdef SHELLY_ALLOCATION_TRACKING
+
+namespace {
+
+void* trackedAllocate(std::size_t size, std::size_t alignment) {
+    shelly::diagnostics::allocationCount++;
+    shelly::diagnostics::allocatedBytes += size;
+
+    if (size == 0) {
+        size = 1;
+    }
+
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return std::malloc(size);
+    }
+
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* pointer = nullptr;
+    return posix_memalign(&pointer, alignment, size) == 0 ? pointer : nullptr;
+#endif
+}
+
+void trackedDeallocate(void* pointer, std::size_t alignment) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    shelly::diagnostics::deallocationCount++;
+
+#ifdef _WIN32
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        _aligned_free(pointer);
+        return;
+    }
+#else
+    static_cast<void>(alignment);
+#endif
+    std::free(pointer);
+}
+
+void* trackedAllocateOrThrow(std::size_t size, std::size_t alignment) {
+    void* pointer = trackedAllocate(size, alignment);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+constexpr std::size_t defaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+} // namespace
+
+void* operator new(std::size_t size) { return trackedAllocateOrThrow(size, defaultAlignment); }
+void* operator new[](std::size_t size) { return trackedAllocateOrThrow(size, defaultAlignment); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return trackedAllocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return trackedAllocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size, defaultAlignment); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size, defaultAlignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return trackedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return trackedAllocate(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* pointer) noexcept { trackedDeallocate(pointer, defaultAlignment); }
+void operator delete[](void* pointer) noexcept { trackedDeallocate(pointer, defaultAlignment); }
+void operator delete(void* pointer, std::size_t) noexcept { trackedDeallocate(pointer, defaultAlignment); }
+void operator delete[](void* pointer, std::size_t) noexcept { trackedDeallocate(pointer, defaultAlignment); }
+void operator delete(void* pointer, std::align_val_t alignment) noexcept { trackedDeallocate(pointer, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept { trackedDeallocate(pointer, static_cast<std::size_t>(alignment)); }
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept { trackedDeallocate(pointer, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept { trackedDeallocate(pointer, static_cast<std::size_t>(alignment)); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { trackedDeallocate(pointer, defaultAlignment); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { trackedDeallocate(pointer, defaultAlignment); }
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept { trackedDeallocate(pointer, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept { trackedDeallocate(pointer, static_cast<std::size_t>(alignment)); }
+
+#endif // SHELLY_ALLOCATION_TRACKING
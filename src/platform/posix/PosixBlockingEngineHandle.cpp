@@ -0,0 +1,45 @@
+#include <cerrno>
+
+#include "PosixIOEngineHandle.hpp"
+
+namespace shelly::platform::detail
+{
+
+namespace {
+
+class BlockingEngineHandle : public IOEngineHandle {
+public:
+
+    IOBackend getBackend() const override { return IOBackend::Blocking; }
+
+    void submit(std::span<IORequest> requests) override {
+        for (IORequest& request : requests) {
+            executeBlocking(request);
+        }
+    }
+
+protected:
+private:
+};
+
+} // namespace
+
+std::unique_ptr<IOEngineHandle> makeBlockingEngineHandle() {
+    return std::make_unique<BlockingEngineHandle>();
+}
+
+void executeBlocking(IORequest& request) {
+    int flags = request.operation == IORequest::Operation::OpenForReading ? readingOpenFlags : writingOpenFlags;
+    int opened;
+    do {
+        opened = open(request.path.c_str(), flags, createdFileMode);
+    } while (opened == -1 && errno == EINTR);
+
+    if (opened == -1) {
+        request.error = errno;
+    } else {
+        request.openedFile = std::make_unique<FileDescriptor>(opened);
+    }
+}
+
+} // namespace shelly::platform::detail
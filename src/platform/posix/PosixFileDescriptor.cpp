@@ -0,0 +1,35 @@
+#include "shelly/platform/FileDescriptor.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace shelly::platform
+{
+
+namespace {
+
+std::unique_ptr<FileDescriptor> openFile(const std::string& path, int flags) {
+    int fd = open(path.c_str(), flags | O_CLOEXEC, 0666);
+    if (fd == -1) {
+        return nullptr;
+    }
+    return std::make_unique<FileDescriptor>(fd);
+}
+
+} // namespace
+
+std::unique_ptr<FileDescriptor> openFileForReading(const std::string& path) {
+    return openFile(path, O_RDONLY);
+}
+
+std::unique_ptr<FileDescriptor> openFileForWriting(const std::string& path) {
+    return openFile(path, O_WRONLY | O_CREAT | O_TRUNC);
+}
+
+FileDescriptor::~FileDescriptor() {
+    if (nativeHandle != invalidHandle) {
+        close(static_cast<int>(nativeHandle));
+    }
+}
+
+} // namespace shelly::platform
@@ -0,0 +1,134 @@
+#include "shelly/platform/HereDocument.hpp"
+
+#include <cerrno>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "shelly/platform/FileDescriptor.hpp"
+#include "PosixPipeHandle.hpp"
+
+namespace shelly::platform
+{
+
+namespace {
+
+/// @brief Number of body parts written with a single writev call.
+constexpr int partsPerWrite = 64;
+
+/// @brief Writes all parts to the descriptor, retrying short writes.
+/// @return True if everything was written.
+bool writeParts(int fd, std::span<const std::string_view> parts) {
+    std::size_t part = 0;
+    std::size_t partOffset = 0;
+
+    while (part < parts.size()) {
+        iovec vectors[partsPerWrite];
+        int vectorCount = 0;
+        for (std::size_t i = part; i < parts.size() && vectorCount < partsPerWrite; i++) {
+            std::size_t skipped = i == part ? partOffset : 0;
+            vectors[vectorCount++] = iovec{const_cast<char*>(parts[i].data()) + skipped, parts[i].size() - skipped};
+        }
+
+        ssize_t written = writev(fd, vectors, vectorCount);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        std::size_t remaining = static_cast<std::size_t>(written);
+        std::size_t firstPart = part;
+        while (part < parts.size() && remaining >= parts[part].size() - partOffset) {
+            remaining -= parts[part].size() - partOffset;
+            part++;
+            partOffset = 0;
+        }
+        partOffset += remaining;
+
+        if (written == 0 && part == firstPart) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Creates an anonymous memory file. It has no name in any file system.
+/// @return Descriptor of the file, or -1 if it could not be created.
+int createMemoryFile() {
+#ifdef MFD_ALLOW_SEALING
+    return memfd_create("shelly-here-document", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+    /// @note Without memfd_create, POSIX shared memory is used, and its name is removed right away.
+    static unsigned counter = 0;
+    char name[64];
+    std::snprintf(name, sizeof(name), "/shelly-here-document-%ld-%u", static_cast<long>(getpid()), counter++);
+
+    /// @note shm_open always sets close-on-exec on the descriptor it opens.
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd == -1) {
+        return -1;
+    }
+    shm_unlink(name);
+    return fd;
+#endif
+}
+
+/// @brief Seals the memory file against modification, and rewinds it so the child reads it from the start.
+/// @return Input for the child, or nullptr if the file could not be rewound.
+std::unique_ptr<FileDescriptor> finishMemoryFile(int fd) {
+#ifdef MFD_ALLOW_SEALING
+    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+#endif
+    if (lseek(fd, 0, SEEK_SET) == -1) {
+        close(fd);
+        return nullptr;
+    }
+    return std::make_unique<FileDescriptor>(fd);
+}
+
+std::unique_ptr<FileDescriptor> makePipedInput(std::span<const std::string_view> body) {
+    int fds[2];
+    if (!detail::createCloseOnExecPipe(fds)) {
+        return nullptr;
+    }
+
+    /// @note Closing the input end lets the child see the end of input once it has read the body.
+    bool written = writeParts(fds[1], body);
+    close(fds[1]);
+    if (!written) {
+        close(fds[0]);
+        return nullptr;
+    }
+    return std::make_unique<FileDescriptor>(fds[0]);
+}
+
+} // namespace
+
+std::unique_ptr<FileDescriptor> makeHereDocumentInput(std::span<const std::string_view> body) {
+    std::size_t size = 0;
+    for (std::string_view part : body) {
+        size += part.size();
+    }
+
+    if (size <= pipedHereDocumentLimit) {
+        return makePipedInput(body);
+    }
+
+    int fd = createMemoryFile();
+    if (fd == -1) {
+        return nullptr;
+    }
+    if (!writeParts(fd, body)) {
+        close(fd);
+        return nullptr;
+    }
+    return finishMemoryFile(fd);
+}
+
+} // namespace shelly::platform
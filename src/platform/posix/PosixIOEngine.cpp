@@ -0,0 +1,80 @@
+#include "shelly/platform/IOEngine.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "PosixIOEngineHandle.hpp"
+
+namespace shelly::platform
+{
+
+namespace {
+
+/// @brief Backend that sets up the requested backend on first use, so engines that never batch never pay for it.
+///
+///        A lone open gains nothing from batching, and setting up an io_uring costs more than the open itself,
+///        so it is executed directly.
+class DeferredEngineHandle : public detail::IOEngineHandle {
+public:
+
+    /// @param requested Requested backend: "io_uring" or "blocking".
+    explicit DeferredEngineHandle(std::string_view requested) : requested(requested) {}
+
+    IOBackend getBackend() const override { return getHandle().getBackend(); }
+
+    void submit(std::span<IORequest> requests) override {
+        if (requests.size() == 1) {
+            detail::executeBlocking(requests.front());
+            return;
+        }
+        getHandle().submit(requests);
+    }
+
+protected:
+private:
+
+    std::string requested;
+    mutable std::unique_ptr<detail::IOEngineHandle> handle;
+
+    detail::IOEngineHandle& getHandle() const {
+        if (handle) {
+            return *handle;
+        }
+        if (requested == "io_uring") {
+            handle = detail::makeIoUringEngineHandle();
+        }
+        if (handle == nullptr) {
+            handle = detail::makeBlockingEngineHandle();
+        }
+        return *handle;
+    }
+
+};
+
+} // namespace
+
+IOEngine::IOEngine(std::unique_ptr<detail::IOEngineHandle> ioEngineHandle) : ioEngineHandle(std::move(ioEngineHandle)) {}
+
+IOEngine::~IOEngine() = default;
+
+IOBackend IOEngine::getBackend() const {
+    return ioEngineHandle->getBackend();
+}
+
+void IOEngine::submit(std::span<IORequest> requests) {
+    if (!requests.empty()) {
+        ioEngineHandle->submit(requests);
+    }
+}
+
+std::unique_ptr<IOEngine> makeIOEngine() {
+    std::string_view requested = "blocking";
+    if (const char* backend = std::getenv("SHELLY_IO_BACKEND"); backend != nullptr && *backend != '\0') {
+        requested = backend;
+    }
+
+    return std::unique_ptr<IOEngine>(new IOEngine(std::make_unique<DeferredEngineHandle>(requested)));
+}
+
+} // namespace shelly::platform
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+#include <fcntl.h>
+
+#include "shelly/platform/IOEngine.hpp"
+
+namespace shelly::platform::detail
+{
+
+/// @brief Flags used for opening files, matching openFileForReading and openFileForWriting.
+inline constexpr int readingOpenFlags = O_RDONLY | O_CLOEXEC;
+inline constexpr int writingOpenFlags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+inline constexpr mode_t createdFileMode = 0666;
+
+/// @brief Backend of an IOEngine.
+class IOEngineHandle {
+public:
+
+    virtual ~IOEngineHandle() = default;
+
+    virtual IOBackend getBackend() const = 0;
+
+    /// @brief Executes all requests, and waits until every one of them is complete.
+    virtual void submit(std::span<IORequest> requests) = 0;
+
+protected:
+private:
+};
+
+/// @brief Creates an io_uring backend.
+/// @return New backend, or nullptr if io_uring is unsupported, disabled, or lacks a required operation.
+std::unique_ptr<IOEngineHandle> makeIoUringEngineHandle();
+
+/// @brief Creates a backend that executes requests with blocking system calls. It is always available.
+/// @return New backend.
+std::unique_ptr<IOEngineHandle> makeBlockingEngineHandle();
+
+/// @brief Executes a single request with blocking system calls.
+void executeBlocking(IORequest& request);
+
+} // namespace shelly::platform::detail
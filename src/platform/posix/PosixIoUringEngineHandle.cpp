@@ -0,0 +1,294 @@
+#include "PosixIOEngineHandle.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace shelly::platform::detail
+{
+
+namespace {
+
+/// @brief Number of submission queue entries. Larger batches are submitted in several rounds.
+constexpr unsigned ringEntries = 64;
+
+/// @note liburing is not required; the ring is driven through the raw system calls.
+int ioUringSetup(unsigned entries, io_uring_params* parameters) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, parameters));
+}
+
+int ioUringEnter(int ringDescriptor, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringDescriptor, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int ringDescriptor, unsigned opcode, void* argument, unsigned argumentCount) {
+    return static_cast<int>(syscall(__NR_io_uring_register, ringDescriptor, opcode, argument, argumentCount));
+}
+
+unsigned loadAcquire(unsigned* value) {
+    return std::atomic_ref<unsigned>(*value).load(std::memory_order_acquire);
+}
+
+void storeRelease(unsigned* value, unsigned newValue) {
+    std::atomic_ref<unsigned>(*value).store(newValue, std::memory_order_release);
+}
+
+/// @brief Memory mapping of a part of the ring, unmapped on destruction.
+struct RingMapping {
+    void* address = MAP_FAILED;
+    std::size_t size = 0;
+
+    RingMapping() = default;
+    RingMapping(const RingMapping&) = delete;
+    RingMapping& operator=(const RingMapping&) = delete;
+
+    ~RingMapping() {
+        if (address != MAP_FAILED) {
+            munmap(address, size);
+        }
+    }
+
+    bool map(int ringDescriptor, std::size_t size, off_t offset) {
+        this->size = size;
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringDescriptor, offset);
+        return address != MAP_FAILED;
+    }
+
+    template<typename T>
+    T* at(std::uint32_t offset) const {
+        return reinterpret_cast<T*>(static_cast<char*>(address) + offset);
+    }
+};
+
+class IoUringEngineHandle : public IOEngineHandle {
+public:
+
+    explicit IoUringEngineHandle(int ringDescriptor) : ringDescriptor(ringDescriptor) {}
+
+    ~IoUringEngineHandle() override {
+        close(ringDescriptor);
+    }
+
+    /// @brief Maps the rings of the io_uring set up with the given parameters.
+    /// @return True if the rings were mapped.
+    bool mapRings(const io_uring_params& parameters) {
+        std::size_t submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned);
+        std::size_t completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+
+        const RingMapping* completionMapping = &completionRing;
+        if (parameters.features & IORING_FEAT_SINGLE_MMAP) {
+            if (!submissionRing.map(ringDescriptor, std::max(submissionRingSize, completionRingSize), IORING_OFF_SQ_RING)) {
+                return false;
+            }
+            completionMapping = &submissionRing;
+        } else if (!submissionRing.map(ringDescriptor, submissionRingSize, IORING_OFF_SQ_RING)
+            || !completionRing.map(ringDescriptor, completionRingSize, IORING_OFF_CQ_RING)) {
+            return false;
+        }
+
+        if (!submissionEntries.map(ringDescriptor, parameters.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES)) {
+            return false;
+        }
+
+        submissionTail = submissionRing.at<unsigned>(parameters.sq_off.tail);
+        submissionMask = *submissionRing.at<unsigned>(parameters.sq_off.ring_mask);
+        submissionArray = submissionRing.at<unsigned>(parameters.sq_off.array);
+        submissionCapacity = parameters.sq_entries;
+        completionHead = completionMapping->at<unsigned>(parameters.cq_off.head);
+        completionTail = completionMapping->at<unsigned>(parameters.cq_off.tail);
+        completionMask = *completionMapping->at<unsigned>(parameters.cq_off.ring_mask);
+        completions = completionMapping->at<io_uring_cqe>(parameters.cq_off.cqes);
+        return true;
+    }
+
+    /// @brief Checks that the kernel supports every operation used by the engine.
+    bool supportsRequiredOperations() {
+        constexpr unsigned probedOperations = IORING_OP_OPENAT + 1;
+        std::vector<char> storage(sizeof(io_uring_probe) + probedOperations * sizeof(io_uring_probe_op));
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+
+        if (ioUringRegister(ringDescriptor, IORING_REGISTER_PROBE, probe, probedOperations) < 0) {
+            return false;
+        }
+
+        return IORING_OP_OPENAT <= probe->last_op && (probe->ops[IORING_OP_OPENAT].flags & IO_URING_OP_SUPPORTED);
+    }
+
+    IOBackend getBackend() const override { return IOBackend::IoUring; }
+
+    void submit(std::span<IORequest> requests) override {
+        /// @note Completions of an abandoned round may still arrive, so a failed ring is never used again.
+        if (ringError != 0) {
+            for (IORequest& request : requests) {
+                executeBlocking(request);
+            }
+            return;
+        }
+
+        std::vector<IORequest*> pending;
+        pending.reserve(requests.size());
+        for (IORequest& request : requests) {
+            pending.push_back(&request);
+        }
+
+        /// @note Interrupted opens are resubmitted in the next round.
+        std::vector<IORequest*> unfinished;
+        while (!pending.empty()) {
+            std::span<IORequest*> round(pending.data(), std::min<std::size_t>(pending.size(), submissionCapacity));
+            submitRound(round, unfinished);
+            if (ringError != 0) {
+                for (IORequest* request : pending) {
+                    if (request->openedFile == nullptr && request->error == 0) {
+                        request->error = ringError;
+                    }
+                }
+                return;
+            }
+
+            pending.erase(pending.begin(), pending.begin() + round.size());
+            pending.insert(pending.end(), unfinished.begin(), unfinished.end());
+            unfinished.clear();
+        }
+    }
+
+protected:
+private:
+
+    void prepare(io_uring_sqe& entry, IORequest& request) {
+        entry = io_uring_sqe{};
+        entry.user_data = reinterpret_cast<std::uintptr_t>(&request);
+        entry.opcode = IORING_OP_OPENAT;
+        entry.fd = AT_FDCWD;
+        entry.addr = reinterpret_cast<std::uintptr_t>(request.path.c_str());
+        entry.len = createdFileMode;
+        entry.open_flags = request.operation == IORequest::Operation::OpenForReading ? readingOpenFlags : writingOpenFlags;
+    }
+
+    void complete(IORequest& request, int result, std::vector<IORequest*>& unfinished) {
+        if (result < 0) {
+            if (result == -EINTR) {
+                unfinished.push_back(&request);
+            } else {
+                request.error = -result;
+            }
+            return;
+        }
+        request.openedFile = std::make_unique<FileDescriptor>(result);
+    }
+
+    /// @brief Reaps all available completions.
+    /// @return Number of completions reaped.
+    std::size_t reapCompletions(std::vector<IORequest*>& unfinished) {
+        unsigned head = *completionHead;
+        unsigned available = loadAcquire(completionTail);
+        std::size_t reaped = 0;
+        for (; head != available; head++) {
+            const io_uring_cqe& completion = completions[head & completionMask];
+            complete(*reinterpret_cast<IORequest*>(completion.user_data), completion.res, unfinished);
+            reaped++;
+        }
+        storeRelease(completionHead, head);
+        return reaped;
+    }
+
+    /// @brief Submits at most submissionCapacity requests with one system call, and reaps all their completions.
+    ///
+    ///        If io_uring_enter fails, the round is abandoned and ringError is set. Unsubmitted entries are taken
+    ///        back from the ring, and requests that did not complete are left without a result.
+    void submitRound(std::span<IORequest*> round, std::vector<IORequest*>& unfinished) {
+        unsigned tail = *submissionTail;
+        for (IORequest* request : round) {
+            unsigned index = tail & submissionMask;
+            prepare(submissionEntries.at<io_uring_sqe>(0)[index], *request);
+            submissionArray[index] = index;
+            tail++;
+        }
+        storeRelease(submissionTail, tail);
+
+        unsigned toSubmit = static_cast<unsigned>(round.size());
+        std::size_t completed = 0;
+        while (completed < round.size()) {
+            unsigned toComplete = static_cast<unsigned>(round.size() - completed);
+            int submitted = ioUringEnter(ringDescriptor, toSubmit, toComplete, IORING_ENTER_GETEVENTS);
+            if (submitted < 0) {
+                int error = errno;
+                if (error == EINTR) {
+                    continue;
+                }
+
+                /// @note A full completion queue or a lack of resources clears up only as completions are reaped,
+                ///       so the call is retried only while reaping makes progress.
+                if (error == EAGAIN || error == EBUSY) {
+                    std::size_t reaped = reapCompletions(unfinished);
+                    completed += reaped;
+                    if (reaped > 0) {
+                        continue;
+                    }
+                }
+
+                storeRelease(submissionTail, tail - toSubmit);
+                ringError = error;
+                return;
+            }
+            toSubmit -= static_cast<unsigned>(submitted);
+            completed += reapCompletions(unfinished);
+        }
+    }
+
+    int ringDescriptor;
+    RingMapping submissionRing;
+    RingMapping completionRing;
+    RingMapping submissionEntries;
+
+    unsigned* submissionTail = nullptr;
+    unsigned submissionMask = 0;
+    unsigned* submissionArray = nullptr;
+    unsigned submissionCapacity = 0;
+    unsigned* completionHead = nullptr;
+    unsigned* completionTail = nullptr;
+    unsigned completionMask = 0;
+    io_uring_cqe* completions = nullptr;
+
+    int ringError = 0;  ///< Error number of a failed io_uring_enter, or 0 while the ring is usable.
+
+};
+
+} // namespace
+
+std::unique_ptr<IOEngineHandle> makeIoUringEngineHandle() {
+    io_uring_params parameters{};
+    int ringDescriptor = ioUringSetup(ringEntries, &parameters);
+    if (ringDescriptor < 0) {
+        return nullptr;
+    }
+
+    auto handle = std::make_unique<IoUringEngineHandle>(ringDescriptor);
+    if (!handle->mapRings(parameters) || !handle->supportsRequiredOperations()) {
+        return nullptr;
+    }
+    return handle;
+}
+
+} // namespace shelly::platform::detail
+
+#else
+
+namespace shelly::platform::detail
+{
+
+std::unique_ptr<IOEngineHandle> makeIoUringEngineHandle() {
+    return nullptr;
+}
+
+} // namespace shelly::platform::detail
+
+#endif // __linux__ && <linux/io_uring.h>
@@ -0,0 +1,48 @@
+#include "shelly/platform/LineReader.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "PosixLineReaderHandle.hpp"
+
+namespace shelly::platform
+{
+
+std::unique_ptr<LineReader> openLineReader(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return nullptr;
+    }
+    return std::unique_ptr<LineReader>(new LineReader(std::make_unique<detail::LineReaderHandle>(fd)));
+}
+
+std::unique_ptr<LineReader> makeStandardInputLineReader() {
+    /// @note The reader owns a duplicate, so the standard input itself stays open and is still inherited by children.
+    int fd = fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, 0);
+    if (fd == -1) {
+        return nullptr;
+    }
+    return std::unique_ptr<LineReader>(new LineReader(std::make_unique<detail::LineReaderHandle>(fd)));
+}
+
+LineReader::LineReader(std::unique_ptr<detail::LineReaderHandle> lineReaderHandle) : lineReaderHandle(std::move(lineReaderHandle)) {}
+
+LineReader::~LineReader() = default;
+
+bool LineReader::readLine(std::string& line) {
+    return lineReaderHandle->readLine(line);
+}
+
+std::string_view LineReader::peek() {
+    return lineReaderHandle->peek();
+}
+
+void LineReader::consume(std::size_t count) {
+    lineReaderHandle->consume(count);
+}
+
+bool LineReader::hasFailed() const {
+    return lineReaderHandle->hasFailed();
+}
+
+} // namespace shelly::platform
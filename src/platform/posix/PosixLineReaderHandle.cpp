@@ -0,0 +1,55 @@
+#include "PosixLineReaderHandle.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace shelly::platform::detail
+{
+
+bool LineReaderHandle::readLine(std::string& line) {
+    line.clear();
+
+    while (true) {
+        const char* unread = buffer + position;
+        std::size_t unreadSize = size - position;
+        if (const void* newline = std::memchr(unread, '\n', unreadSize)) {
+            std::size_t lineSize = static_cast<std::size_t>(static_cast<const char*>(newline) - unread);
+            line.append(unread, lineSize);
+            position += lineSize + 1;
+            return true;
+        }
+        line.append(unread, unreadSize);
+        position = 0;
+        size = 0;
+
+        ssize_t readCount = read(static_cast<int>(file.getNativeHandle()), buffer, bufferSize);
+        if (readCount == -1 && errno == EINTR) {
+            continue;
+        }
+        if (readCount <= 0) {
+            failed = readCount == -1;
+            return !line.empty();
+        }
+        size = static_cast<std::size_t>(readCount);
+    }
+}
+
+std::string_view LineReaderHandle::peek() {
+    while (position == size && !failed) {
+        ssize_t readCount = read(static_cast<int>(file.getNativeHandle()), buffer, bufferSize);
+        if (readCount == -1 && errno == EINTR) {
+            continue;
+        }
+        if (readCount <= 0) {
+            failed = readCount == -1;
+            break;
+        }
+        position = 0;
+        size = static_cast<std::size_t>(readCount);
+    }
+    return std::string_view(buffer + position, size - position);
+}
+
+} // namespace shelly::platform::detail
@@ -0,0 +1,104 @@
+#include "shelly/platform/LockedFile.hpp"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "PosixLockedFileHandle.hpp"
+
+namespace shelly::platform
+{
+
+namespace {
+
+/// @brief Permissions of the replaced file and the lock file, before the umask is applied.
+constexpr mode_t createdFileMode = 0666;
+
+/// @brief Writes all of the contents to the descriptor, retrying short writes.
+/// @return True if everything was written.
+bool writeAll(int fd, std::string_view contents) {
+    while (!contents.empty()) {
+        ssize_t written = write(fd, contents.data(), contents.size());
+        if (written == -1 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        contents.remove_prefix(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+
+} // namespace
+
+std::unique_ptr<LockedFile> lockFile(const std::string& path) {
+    std::string lockPath = path + ".lock";
+    int fd = open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, createdFileMode);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    int result;
+    do {
+        result = flock(fd, LOCK_EX);
+    } while (result == -1 && errno == EINTR);
+    if (result == -1) {
+        close(fd);
+        return nullptr;
+    }
+
+    return std::unique_ptr<LockedFile>(new LockedFile(std::make_unique<detail::LockedFileHandle>(path, fd)));
+}
+
+LockedFile::LockedFile(std::unique_ptr<detail::LockedFileHandle> lockedFileHandle) : lockedFileHandle(std::move(lockedFileHandle)) {}
+
+LockedFile::~LockedFile() = default;
+
+std::optional<std::string> LockedFile::read() const {
+    std::string contents;
+    int fd = open(lockedFileHandle->getPath().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return errno == ENOENT ? std::optional<std::string>(contents) : std::nullopt;
+    }
+
+    char buffer[4096];
+    while (true) {
+        ssize_t readCount = ::read(fd, buffer, sizeof(buffer));
+        if (readCount == -1 && errno == EINTR) {
+            continue;
+        }
+        if (readCount <= 0) {
+            close(fd);
+            return readCount == 0 ? std::optional<std::string>(std::move(contents)) : std::nullopt;
+        }
+        contents.append(buffer, static_cast<std::size_t>(readCount));
+    }
+}
+
+bool LockedFile::replace(std::string_view contents) {
+    const std::string& path = lockedFileHandle->getPath();
+    std::string temporaryPath = path + ".XXXXXX";
+    int fd = mkstemp(temporaryPath.data());
+    if (fd == -1) {
+        return false;
+    }
+
+    /// @note mkstemp creates the file readable only by its owner. The replaced file gets the usual permissions instead,
+    ///       so readers like the node_exporter textfile collector can still read it.
+    mode_t mask = umask(0);
+    umask(mask);
+    fchmod(fd, createdFileMode & ~mask);
+
+    bool written = writeAll(fd, contents);
+    if (close(fd) != 0 || !written || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace shelly::platform
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "shelly/platform/FileDescriptor.hpp"
+
+namespace shelly::platform::detail
+{
+
+class LockedFileHandle {
+public:
+
+    /// @brief Takes ownership of a locked lock file. Closing it releases the lock.
+    /// @param path Path of the locked file.
+    /// @param lock Lock file, locked with flock.
+    LockedFileHandle(std::string path, FileDescriptor::NativeHandle lock) : path(std::move(path)), lock(lock) {}
+
+    inline const std::string& getPath() const { return path; }
+
+protected:
+private:
+
+    std::string path;
+    FileDescriptor lock;
+
+};
+
+} // namespace shelly::platform::detail
@@ -1,6 +1,30 @@
 #include "shelly/platform/Pipe.hpp"
 
+#include "PosixPipeHandle.hpp"
+
 namespace shelly::platform
 {
-    
+
+std::unique_ptr<Pipe> makePipe() {
+    /// @note Both ends are close-on-exec, so only the process that the end is redirected to inherits it.
+    int fds[2];
+    if (!detail::createCloseOnExecPipe(fds)) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<Pipe>(new Pipe(std::make_unique<detail::PipeHandle>(fds[0], fds[1])));
+}
+
+Pipe::Pipe(std::unique_ptr<detail::PipeHandle> pipeHandle) : pipeHandle(std::move(pipeHandle)) {}
+
+Pipe::~Pipe() = default;
+
+const FileDescriptor& Pipe::getInputFileDescriptor() const {
+    return pipeHandle->getWriteEnd();
+}
+
+const FileDescriptor& Pipe::getOutputFileDescriptor() const {
+    return pipeHandle->getReadEnd();
+}
+
 } // namespace shelly::platform
@@ -1,6 +1,23 @@
 #include "PosixPipeHandle.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace shelly::platform::detail
 {
-    
+
+bool createCloseOnExecPipe(int (&fds)[2]) {
+#ifdef __APPLE__
+    /// @note macOS has no pipe2, so the flags are set right after the pipe is created.
+    if (pipe(fds) == -1) {
+        return false;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#else
+    return pipe2(fds, O_CLOEXEC) == 0;
+#endif
+}
+
 } // namespace shelly::platform::detail
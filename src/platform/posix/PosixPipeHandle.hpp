@@ -1,12 +1,32 @@
 #pragma once
 
+#include "shelly/platform/FileDescriptor.hpp"
+
 namespace shelly::platform::detail
 {
     
 class PipeHandle {
 public:
+
+    /// @brief Takes ownership of both ends of a POSIX pipe.
+    /// @param readEnd  Read end of the pipe.
+    /// @param writeEnd Write end of the pipe.
+    PipeHandle(int readEnd, int writeEnd) : readEnd(readEnd), writeEnd(writeEnd) {}
+
+    inline const FileDescriptor& getReadEnd() const { return readEnd; }
+    inline const FileDescriptor& getWriteEnd() const { return writeEnd; }
+
 protected:
 private:
+
+    FileDescriptor readEnd;
+    FileDescriptor writeEnd;
+
 };
 
+/// @brief Creates a pipe whose ends are close-on-exec from the start, so a concurrent spawn never inherits them.
+/// @param fds Receives the read end and the write end.
+/// @return True if the pipe was created.
+bool createCloseOnExecPipe(int (&fds)[2]);
+
 } // namespace shelly::platform::detail
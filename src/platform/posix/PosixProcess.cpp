@@ -1,6 +1,112 @@
 #include "shelly/platform/Process.hpp"
 
+#include <cerrno>
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "PosixProcessHandle.hpp"
+
+extern char** environ;
+
 namespace shelly::platform
 {
-    
+
+Process::Process(std::unique_ptr<detail::ProcessHandle> processHandle) : processHandle(std::move(processHandle)) {}
+
+Process::~Process() = default;
+
+int Process::wait() {
+    return processHandle->wait();
+}
+
+const ProcessStatistics& Process::getStatistics() const {
+    return processHandle->getStatistics();
+}
+
+void waitForAll(std::span<Process* const> processes) {
+    while (true) {
+        Process* firstPending = nullptr;
+        for (Process* process : processes) {
+            if (process != nullptr && !process->processHandle->isWaited()) {
+                firstPending = process;
+                break;
+            }
+        }
+        if (firstPending == nullptr) {
+            return;
+        }
+
+        /// @note WNOWAIT finds the next child to exit without reaping it, so only our own processes are reaped.
+        siginfo_t info{};
+        if (waitid(P_ALL, 0, &info, WEXITED | WNOWAIT) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            firstPending->wait();
+            continue;
+        }
+
+        Process* exited = firstPending;
+        for (Process* process : processes) {
+            if (process != nullptr && !process->processHandle->isWaited() && process->processHandle->getPid() == info.si_pid) {
+                exited = process;
+                break;
+            }
+        }
+        exited->wait();
+    }
+}
+
+ProcessBuilder& ProcessBuilder::redirectOutput(const FileDescriptor& output) {
+    this->output = output.getNativeHandle();
+    return *this;
+}
+
+ProcessBuilder& ProcessBuilder::redirectInput(const FileDescriptor& input) {
+    this->input = input.getNativeHandle();
+    return *this;
+}
+
+ProcessBuilder& ProcessBuilder::redirectError(const FileDescriptor& error) {
+    this->error = error.getNativeHandle();
+    return *this;
+}
+
+std::unique_ptr<Process> ProcessBuilder::spawn() {
+    std::vector<char*> argv;
+    argv.reserve(arguments.size() + 1);
+    for (std::string& argument : arguments) {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+
+    /// @note dup2 clears close-on-exec on the target, so redirected descriptors survive exec.
+    if (input != FileDescriptor::invalidHandle) {
+        posix_spawn_file_actions_adddup2(&fileActions, static_cast<int>(input), STDIN_FILENO);
+    }
+    if (output != FileDescriptor::invalidHandle) {
+        posix_spawn_file_actions_adddup2(&fileActions, static_cast<int>(output), STDOUT_FILENO);
+    }
+    if (error != FileDescriptor::invalidHandle) {
+        posix_spawn_file_actions_adddup2(&fileActions, static_cast<int>(error), STDERR_FILENO);
+    }
+
+    auto spawnTime = std::chrono::steady_clock::now();
+
+    pid_t pid;
+    int spawnResult = posix_spawnp(&pid, argv[0], &fileActions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&fileActions);
+
+    if (spawnResult != 0) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<Process>(new Process(std::make_unique<detail::ProcessHandle>(pid, spawnTime)));
+}
+
 } // namespace shelly::platform
@@ -1,6 +1,55 @@
 #include "PosixProcessHandle.hpp"
 
+#include <cerrno>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+
 namespace shelly::platform::detail
 {
-    
+
+namespace {
+
+std::chrono::microseconds toMicroseconds(const timeval& time) {
+    return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+}
+
+} // namespace
+
+int ProcessHandle::wait() {
+    if (exitStatus.has_value()) {
+        return *exitStatus;
+    }
+
+    int status = 0;
+    rusage usage{};
+    while (wait4(pid, &status, 0, &usage) == -1) {
+        if (errno != EINTR) {
+            exitStatus = 127;
+            return *exitStatus;
+        }
+    }
+
+    statistics.wallTime = std::chrono::steady_clock::now() - spawnTime;
+    statistics.userTime = toMicroseconds(usage.ru_utime);
+    statistics.systemTime = toMicroseconds(usage.ru_stime);
+    /// @note Linux reports ru_maxrss in kilobytes, macOS in bytes.
+#ifdef __APPLE__
+    statistics.maxResidentSetKilobytes = usage.ru_maxrss / 1024;
+#else
+    statistics.maxResidentSetKilobytes = usage.ru_maxrss;
+#endif
+    statistics.voluntaryContextSwitches = usage.ru_nvcsw;
+    statistics.involuntaryContextSwitches = usage.ru_nivcsw;
+    statistics.minorPageFaults = usage.ru_minflt;
+    statistics.majorPageFaults = usage.ru_majflt;
+
+    if (WIFSIGNALED(status)) {
+        exitStatus = 128 + WTERMSIG(status);
+    } else {
+        exitStatus = WEXITSTATUS(status);
+    }
+    return *exitStatus;
+}
+
 } // namespace shelly::platform::detail
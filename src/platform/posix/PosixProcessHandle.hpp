@@ -1,12 +1,39 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
+
+#include <sys/types.h>
+
+#include "shelly/platform/Process.hpp"
+
 namespace shelly::platform::detail
 {
     
 class ProcessHandle {
 public:
+
+    /// @brief Instantiate a handle for a spawned child process.
+    /// @param pid       Process ID of the child.
+    /// @param spawnTime Time just before the child was spawned.
+    ProcessHandle(pid_t pid, std::chrono::steady_clock::time_point spawnTime) : pid(pid), spawnTime(spawnTime) {}
+
+    /// @brief Waits for the child to exit, reaps it, and collects its resource usage.
+    /// @return Exit status of the child. If the child was terminated by a signal, 128 + signal number.
+    int wait();
+
+    inline pid_t getPid() const { return pid; }
+    inline bool isWaited() const { return exitStatus.has_value(); }
+    inline const ProcessStatistics& getStatistics() const { return statistics; }
+
 protected:
 private:
+
+    pid_t pid;
+    std::chrono::steady_clock::time_point spawnTime;
+    std::optional<int> exitStatus;
+    ProcessStatistics statistics;
+
 };
 
 } // namespace shelly::platform::detail
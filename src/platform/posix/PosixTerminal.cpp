@@ -0,0 +1,12 @@
+#include "shelly/platform/Terminal.hpp"
+
+#include <unistd.h>
+
+namespace shelly::platform
+{
+
+bool isStandardInputTerminal() {
+    return isatty(STDIN_FILENO) == 1;
+}
+
+} // namespace shelly::platform
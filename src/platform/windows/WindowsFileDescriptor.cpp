@@ -0,0 +1,34 @@
+#include "shelly/platform/FileDescriptor.hpp"
+
+#include <windows.h>
+
+namespace shelly::platform
+{
+
+namespace {
+
+std::unique_ptr<FileDescriptor> openFile(const std::string& path, DWORD access, DWORD creationDisposition) {
+    HANDLE handle = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, creationDisposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    return std::make_unique<FileDescriptor>(reinterpret_cast<FileDescriptor::NativeHandle>(handle));
+}
+
+} // namespace
+
+std::unique_ptr<FileDescriptor> openFileForReading(const std::string& path) {
+    return openFile(path, GENERIC_READ, OPEN_EXISTING);
+}
+
+std::unique_ptr<FileDescriptor> openFileForWriting(const std::string& path) {
+    return openFile(path, GENERIC_WRITE, CREATE_ALWAYS);
+}
+
+FileDescriptor::~FileDescriptor() {
+    if (nativeHandle != invalidHandle) {
+        CloseHandle(reinterpret_cast<HANDLE>(nativeHandle));
+    }
+}
+
+} // namespace shelly::platform
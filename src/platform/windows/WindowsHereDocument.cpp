@@ -0,0 +1,66 @@
+#include "shelly/platform/HereDocument.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <windows.h>
+
+#include "shelly/platform/FileDescriptor.hpp"
+
+namespace shelly::platform
+{
+
+namespace {
+
+/// @brief Here-document body being written into a pipe by a helper thread. Owned by the thread.
+struct PipeWriter {
+    HANDLE writeEnd;
+    std::string body;
+};
+
+/// @note Closing the input end lets the child see the end of input once it has read the body.
+///       A write fails only once the child closes its input, and then the rest of the body is dropped.
+DWORD WINAPI writeBody(LPVOID parameter) {
+    std::unique_ptr<PipeWriter> writer(static_cast<PipeWriter*>(parameter));
+    std::string_view rest = writer->body;
+    while (!rest.empty()) {
+        DWORD count = 0;
+        DWORD chunk = static_cast<DWORD>((std::min)(rest.size(), static_cast<std::size_t>(MAXDWORD)));
+        if (!WriteFile(writer->writeEnd, rest.data(), chunk, &count, nullptr)) {
+            break;
+        }
+        rest.remove_prefix(count);
+    }
+    CloseHandle(writer->writeEnd);
+    return 0;
+}
+
+} // namespace
+
+std::unique_ptr<FileDescriptor> makeHereDocumentInput(std::span<const std::string_view> body) {
+    /// @note Windows has no anonymous memory files that can be a child's input, and pipe buffer sizes are only
+    ///       advisory, so every body is written by a helper thread while the child reads it. The shell never
+    ///       blocks on a pipe the child has not drained. The thread owns a copy, as the body does not outlive the spawn.
+    auto writer = std::make_unique<PipeWriter>();
+    for (std::string_view part : body) {
+        writer->body += part;
+    }
+
+    HANDLE readEnd;
+    if (!CreatePipe(&readEnd, &writer->writeEnd, nullptr, static_cast<DWORD>(pipedHereDocumentLimit))) {
+        return nullptr;
+    }
+
+    HANDLE thread = CreateThread(nullptr, 0, writeBody, writer.get(), 0, nullptr);
+    if (thread == nullptr) {
+        CloseHandle(writer->writeEnd);
+        CloseHandle(readEnd);
+        return nullptr;
+    }
+    writer.release();
+    CloseHandle(thread);
+
+    return std::make_unique<FileDescriptor>(reinterpret_cast<FileDescriptor::NativeHandle>(readEnd));
+}
+
+} // namespace shelly::platform
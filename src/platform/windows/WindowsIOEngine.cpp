@@ -0,0 +1,26 @@
+#include "shelly/platform/IOEngine.hpp"
+
+#include "WindowsIOEngineHandle.hpp"
+
+namespace shelly::platform
+{
+
+IOEngine::IOEngine(std::unique_ptr<detail::IOEngineHandle> ioEngineHandle) : ioEngineHandle(std::move(ioEngineHandle)) {}
+
+IOEngine::~IOEngine() = default;
+
+IOBackend IOEngine::getBackend() const {
+    return ioEngineHandle->getBackend();
+}
+
+void IOEngine::submit(std::span<IORequest> requests) {
+    if (!requests.empty()) {
+        ioEngineHandle->submit(requests);
+    }
+}
+
+std::unique_ptr<IOEngine> makeIOEngine() {
+    return std::unique_ptr<IOEngine>(new IOEngine(std::make_unique<detail::IOEngineHandle>()));
+}
+
+} // namespace shelly::platform
@@ -0,0 +1,26 @@
+#include "WindowsIOEngineHandle.hpp"
+
+#include <windows.h>
+
+namespace shelly::platform::detail
+{
+
+namespace {
+
+void execute(IORequest& request) {
+    bool reading = request.operation == IORequest::Operation::OpenForReading;
+    request.openedFile = reading ? openFileForReading(request.path) : openFileForWriting(request.path);
+    if (request.openedFile == nullptr) {
+        request.error = static_cast<int>(GetLastError());
+    }
+}
+
+} // namespace
+
+void IOEngineHandle::submit(std::span<IORequest> requests) {
+    for (IORequest& request : requests) {
+        execute(request);
+    }
+}
+
+} // namespace shelly::platform::detail
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <span>
+
+#include "shelly/platform/IOEngine.hpp"
+
+namespace shelly::platform::detail
+{
+
+/// @brief Executes requests one after another with blocking Win32 calls.
+class IOEngineHandle {
+public:
+
+    inline IOBackend getBackend() const { return IOBackend::Blocking; }
+
+    void submit(std::span<IORequest> requests);
+
+protected:
+private:
+};
+
+} // namespace shelly::platform::detail
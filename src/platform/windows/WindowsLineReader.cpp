@@ -0,0 +1,51 @@
+#include "shelly/platform/LineReader.hpp"
+
+#include <windows.h>
+
+#include "WindowsLineReaderHandle.hpp"
+
+namespace shelly::platform
+{
+
+std::unique_ptr<LineReader> openLineReader(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    return std::unique_ptr<LineReader>(new LineReader(std::make_unique<detail::LineReaderHandle>(
+        reinterpret_cast<FileDescriptor::NativeHandle>(file))));
+}
+
+std::unique_ptr<LineReader> makeStandardInputLineReader() {
+    /// @note The reader owns a duplicate that is not inheritable, so the standard input itself stays open.
+    HANDLE process = GetCurrentProcess();
+    HANDLE input;
+    if (!DuplicateHandle(process, GetStdHandle(STD_INPUT_HANDLE), process, &input, 0, FALSE, DUPLICATE_SAME_ACCESS)) {
+        return nullptr;
+    }
+    return std::unique_ptr<LineReader>(new LineReader(std::make_unique<detail::LineReaderHandle>(
+        reinterpret_cast<FileDescriptor::NativeHandle>(input))));
+}
+
+LineReader::LineReader(std::unique_ptr<detail::LineReaderHandle> lineReaderHandle) : lineReaderHandle(std::move(lineReaderHandle)) {}
+
+LineReader::~LineReader() = default;
+
+bool LineReader::readLine(std::string& line) {
+    return lineReaderHandle->readLine(line);
+}
+
+std::string_view LineReader::peek() {
+    return lineReaderHandle->peek();
+}
+
+void LineReader::consume(std::size_t count) {
+    lineReaderHandle->consume(count);
+}
+
+bool LineReader::hasFailed() const {
+    return lineReaderHandle->hasFailed();
+}
+
+} // namespace shelly::platform
@@ -0,0 +1,68 @@
+#include "WindowsLineReaderHandle.hpp"
+
+#include <cstring>
+
+#include <windows.h>
+
+namespace shelly::platform::detail
+{
+
+bool LineReaderHandle::readLine(std::string& line) {
+    line.clear();
+
+    while (true) {
+        const char* unread = buffer + position;
+        std::size_t unreadSize = size - position;
+        if (const void* newline = std::memchr(unread, '\n', unreadSize)) {
+            std::size_t lineSize = static_cast<std::size_t>(static_cast<const char*>(newline) - unread);
+            line.append(unread, lineSize);
+            position += lineSize + 1;
+            /// @note Lines typed into the console end with a carriage return and a newline.
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+        line.append(unread, unreadSize);
+        position = 0;
+        size = 0;
+
+        DWORD readCount;
+        if (!ReadFile(reinterpret_cast<HANDLE>(file.getNativeHandle()), buffer, static_cast<DWORD>(bufferSize), &readCount, nullptr)) {
+            /// @note The write end of a pipe being closed is the end of input, not an error.
+            failed = GetLastError() != ERROR_BROKEN_PIPE;
+            return !line.empty();
+        }
+        if (readCount == 0) {
+            return !line.empty();
+        }
+        size = readCount;
+    }
+}
+
+std::string_view LineReaderHandle::peek() {
+    while (position == size && !failed) {
+        DWORD readCount;
+        if (!ReadFile(reinterpret_cast<HANDLE>(file.getNativeHandle()), buffer, static_cast<DWORD>(bufferSize), &readCount, nullptr)) {
+            failed = GetLastError() != ERROR_BROKEN_PIPE;
+            break;
+        }
+        if (readCount == 0) {
+            break;
+        }
+        position = 0;
+        size = readCount;
+
+        /// @note Carriage returns of console lines are dropped, as readLine drops them.
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            if (buffer[i] != '\r' || i + 1 == size || buffer[i + 1] != '\n') {
+                buffer[kept++] = buffer[i];
+            }
+        }
+        size = kept;
+    }
+    return std::string_view(buffer + position, size - position);
+}
+
+} // namespace shelly::platform::detail
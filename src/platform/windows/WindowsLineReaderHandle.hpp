@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "shelly/platform/FileDescriptor.hpp"
+
+namespace shelly::platform::detail
+{
+
+class LineReaderHandle {
+public:
+
+    /// @brief Takes ownership of an open file.
+    /// @param file File to read lines from.
+    explicit LineReaderHandle(FileDescriptor::NativeHandle file) : file(file) {}
+
+    bool readLine(std::string& line);
+    std::string_view peek();
+    inline void consume(std::size_t count) { position += count; }
+    inline bool hasFailed() const { return failed; }
+
+protected:
+private:
+
+    /// @brief Size of the read buffer. Matches the block size other shells read scripts with.
+    static constexpr std::size_t bufferSize = 8192;
+
+    FileDescriptor file;
+    char buffer[bufferSize];
+    std::size_t position = 0;   ///< Start of the unread part of the buffer.
+    std::size_t size = 0;       ///< End of the unread part of the buffer.
+    bool failed = false;
+
+};
+
+} // namespace shelly::platform::detail
@@ -0,0 +1,79 @@
+#include "shelly/platform/LockedFile.hpp"
+
+#include <algorithm>
+
+#include <windows.h>
+
+#include "WindowsLockedFileHandle.hpp"
+
+namespace shelly::platform
+{
+
+std::unique_ptr<LockedFile> lockFile(const std::string& path) {
+    std::string lockPath = path + ".lock";
+    HANDLE lock = CreateFileA(lockPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (lock == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    OVERLAPPED overlapped = {};
+    if (!LockFileEx(lock, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+        CloseHandle(lock);
+        return nullptr;
+    }
+
+    return std::unique_ptr<LockedFile>(new LockedFile(std::make_unique<detail::LockedFileHandle>(
+        path, reinterpret_cast<FileDescriptor::NativeHandle>(lock))));
+}
+
+LockedFile::LockedFile(std::unique_ptr<detail::LockedFileHandle> lockedFileHandle) : lockedFileHandle(std::move(lockedFileHandle)) {}
+
+LockedFile::~LockedFile() = default;
+
+std::optional<std::string> LockedFile::read() const {
+    std::string contents;
+    HANDLE file = CreateFileA(lockedFileHandle->getPath().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        return error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND ? std::optional<std::string>(contents) : std::nullopt;
+    }
+
+    char buffer[4096];
+    DWORD readCount;
+    bool succeeded;
+    while ((succeeded = ReadFile(file, buffer, sizeof(buffer), &readCount, nullptr)) && readCount > 0) {
+        contents.append(buffer, readCount);
+    }
+    CloseHandle(file);
+
+    return succeeded ? std::optional<std::string>(std::move(contents)) : std::nullopt;
+}
+
+bool LockedFile::replace(std::string_view contents) {
+    const std::string& path = lockedFileHandle->getPath();
+
+    /// @note The temporary file is unique to the process, and only the lock holder writes it.
+    std::string temporaryPath = path + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+    HANDLE file = CreateFileA(temporaryPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    bool written = true;
+    while (written && !contents.empty()) {
+        DWORD writtenCount;
+        written = WriteFile(file, contents.data(), static_cast<DWORD>((std::min)(contents.size(), static_cast<std::size_t>(MAXDWORD))), &writtenCount, nullptr);
+        contents.remove_prefix(writtenCount);
+    }
+    CloseHandle(file);
+
+    if (!written || !MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileA(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace shelly::platform
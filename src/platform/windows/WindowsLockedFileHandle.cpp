@@ -0,0 +1,13 @@
+#include "WindowsLockedFileHandle.hpp"
+
+#include <windows.h>
+
+namespace shelly::platform::detail
+{
+
+LockedFileHandle::~LockedFileHandle() {
+    OVERLAPPED overlapped = {};
+    UnlockFileEx(reinterpret_cast<HANDLE>(lock.getNativeHandle()), 0, MAXDWORD, MAXDWORD, &overlapped);
+}
+
+} // namespace shelly::platform::detail
@@ -1,6 +1,35 @@
 #include "shelly/platform/Pipe.hpp"
 
+#include <windows.h>
+
+#include "WindowsPipeHandle.hpp"
+
 namespace shelly::platform
 {
-    
+
+std::unique_ptr<Pipe> makePipe() {
+    HANDLE readEnd;
+    HANDLE writeEnd;
+    if (!CreatePipe(&readEnd, &writeEnd, nullptr, 0)) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<Pipe>(new Pipe(std::make_unique<detail::PipeHandle>(
+        reinterpret_cast<FileDescriptor::NativeHandle>(readEnd),
+        reinterpret_cast<FileDescriptor::NativeHandle>(writeEnd)
+    )));
+}
+
+Pipe::Pipe(std::unique_ptr<detail::PipeHandle> pipeHandle) : pipeHandle(std::move(pipeHandle)) {}
+
+Pipe::~Pipe() = default;
+
+const FileDescriptor& Pipe::getInputFileDescriptor() const {
+    return pipeHandle->getWriteEnd();
+}
+
+const FileDescriptor& Pipe::getOutputFileDescriptor() const {
+    return pipeHandle->getReadEnd();
+}
+
 } // namespace shelly::platform
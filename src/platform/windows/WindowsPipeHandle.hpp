@@ -1,12 +1,27 @@
 #pragma once
 
+#include "shelly/platform/FileDescriptor.hpp"
+
 namespace shelly::platform::detail
 {
     
 class PipeHandle {
 public:
+
+    /// @brief Takes ownership of both ends of an anonymous Windows pipe.
+    /// @param readEnd  Read end of the pipe.
+    /// @param writeEnd Write end of the pipe.
+    PipeHandle(FileDescriptor::NativeHandle readEnd, FileDescriptor::NativeHandle writeEnd) : readEnd(readEnd), writeEnd(writeEnd) {}
+
+    inline const FileDescriptor& getReadEnd() const { return readEnd; }
+    inline const FileDescriptor& getWriteEnd() const { return writeEnd; }
+
 protected:
 private:
+
+    FileDescriptor readEnd;
+    FileDescriptor writeEnd;
+
 };
 
 } // namespace shelly::platform::detail
@@ -1,6 +1,183 @@
 #include "shelly/platform/Process.hpp"
 
+#include <windows.h>
+
+#include "WindowsProcessHandle.hpp"
+
 namespace shelly::platform
 {
-    
+
+namespace {
+
+/// @brief Appends an argument to a command line, quoted so the C runtime of the child parses it back unchanged.
+void appendQuotedArgument(std::string& commandLine, const std::string& argument) {
+    if (!argument.empty() && argument.find_first_of(" \t\n\v\"") == std::string::npos) {
+        commandLine += argument;
+        return;
+    }
+
+    /// @note Backslashes are literal, unless they precede a quote. Then, each of them is escaped, as is the quote.
+    commandLine += '"';
+    std::size_t backslashes = 0;
+    for (char character : argument) {
+        if (character == '\\') {
+            backslashes++;
+            continue;
+        }
+        commandLine.append(character == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+        commandLine += character;
+        backslashes = 0;
+    }
+    commandLine.append(backslashes * 2, '\\');
+    commandLine += '"';
+}
+
+/// @brief Returns the redirected handle, or the shell's own standard handle if the stream is not redirected.
+HANDLE standardHandle(FileDescriptor::NativeHandle redirected, DWORD standardHandleId) {
+    if (redirected != FileDescriptor::invalidHandle) {
+        return reinterpret_cast<HANDLE>(redirected);
+    }
+    return GetStdHandle(standardHandleId);
+}
+
+} // namespace
+
+Process::Process(std::unique_ptr<detail::ProcessHandle> processHandle) : processHandle(std::move(processHandle)) {}
+
+Process::~Process() = default;
+
+int Process::wait() {
+    return processHandle->wait();
+}
+
+const ProcessStatistics& Process::getStatistics() const {
+    return processHandle->getStatistics();
+}
+
+void waitForAll(std::span<Process* const> processes) {
+    while (true) {
+        HANDLE pendingHandles[MAXIMUM_WAIT_OBJECTS];
+        Process* pendingProcesses[MAXIMUM_WAIT_OBJECTS];
+        DWORD pendingCount = 0;
+        for (Process* process : processes) {
+            if (process != nullptr && !process->processHandle->isWaited() && pendingCount < MAXIMUM_WAIT_OBJECTS) {
+                pendingHandles[pendingCount] = reinterpret_cast<HANDLE>(process->processHandle->getProcess());
+                pendingProcesses[pendingCount] = process;
+                pendingCount++;
+            }
+        }
+        if (pendingCount == 0) {
+            return;
+        }
+
+        /// @note The first process to exit is waited for first, so the wall time of each is accurate.
+        DWORD signaled = WaitForMultipleObjects(pendingCount, pendingHandles, FALSE, INFINITE) - WAIT_OBJECT_0;
+        if (signaled < pendingCount) {
+            pendingProcesses[signaled]->wait();
+        } else {
+            pendingProcesses[0]->wait();
+        }
+    }
+}
+
+ProcessBuilder& ProcessBuilder::redirectOutput(const FileDescriptor& output) {
+    this->output = output.getNativeHandle();
+    return *this;
+}
+
+ProcessBuilder& ProcessBuilder::redirectInput(const FileDescriptor& input) {
+    this->input = input.getNativeHandle();
+    return *this;
+}
+
+ProcessBuilder& ProcessBuilder::redirectError(const FileDescriptor& error) {
+    this->error = error.getNativeHandle();
+    return *this;
+}
+
+std::unique_ptr<Process> ProcessBuilder::spawn() {
+    if (arguments.empty()) {
+        return nullptr;
+    }
+
+    std::string commandLine;
+    for (const std::string& argument : arguments) {
+        if (!commandLine.empty()) {
+            commandLine += ' ';
+        }
+        appendQuotedArgument(commandLine, argument);
+    }
+
+    /// @note The shell's own handles are never inheritable. The standard handles of the child are duplicated as
+    ///       inheritable, and listed explicitly, so the child inherits them and nothing else.
+    HANDLE currentProcess = GetCurrentProcess();
+    HANDLE standardHandles[3] = {
+        standardHandle(input, STD_INPUT_HANDLE),
+        standardHandle(output, STD_OUTPUT_HANDLE),
+        standardHandle(error, STD_ERROR_HANDLE),
+    };
+    HANDLE inheritedHandles[3] = {nullptr, nullptr, nullptr};
+    HANDLE inheritedList[3];
+    DWORD inheritedCount = 0;
+    for (int i = 0; i < 3; i++) {
+        if (standardHandles[i] == nullptr || standardHandles[i] == INVALID_HANDLE_VALUE) {
+            continue;
+        }
+        if (DuplicateHandle(currentProcess, standardHandles[i], currentProcess, &inheritedHandles[i], 0, TRUE, DUPLICATE_SAME_ACCESS)) {
+            inheritedList[inheritedCount++] = inheritedHandles[i];
+        }
+    }
+    auto closeInheritedHandles = [&inheritedHandles]() {
+        for (HANDLE handle : inheritedHandles) {
+            if (handle != nullptr) {
+                CloseHandle(handle);
+            }
+        }
+    };
+
+    STARTUPINFOEXA startupInfo{};
+    startupInfo.StartupInfo.cb = sizeof(startupInfo);
+    startupInfo.StartupInfo.dwFlags = STARTF_USESTDHANDLES;
+    startupInfo.StartupInfo.hStdInput = inheritedHandles[0];
+    startupInfo.StartupInfo.hStdOutput = inheritedHandles[1];
+    startupInfo.StartupInfo.hStdError = inheritedHandles[2];
+
+    SIZE_T attributeListSize = 0;
+    InitializeProcThreadAttributeList(nullptr, 1, 0, &attributeListSize);
+    std::vector<char> attributeListStorage(attributeListSize);
+    auto attributeList = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>(attributeListStorage.data());
+    if (!InitializeProcThreadAttributeList(attributeList, 1, 0, &attributeListSize)) {
+        closeInheritedHandles();
+        return nullptr;
+    }
+    DWORD creationFlags = 0;
+    if (inheritedCount > 0) {
+        if (!UpdateProcThreadAttribute(attributeList, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST,
+                inheritedList, inheritedCount * sizeof(HANDLE), nullptr, nullptr)) {
+            DeleteProcThreadAttributeList(attributeList);
+            closeInheritedHandles();
+            return nullptr;
+        }
+        startupInfo.lpAttributeList = attributeList;
+        creationFlags |= EXTENDED_STARTUPINFO_PRESENT;
+    }
+
+    auto spawnTime = std::chrono::steady_clock::now();
+
+    /// @note Without an application name, CreateProcess searches for the program, including in PATH, and appends .exe to it.
+    PROCESS_INFORMATION processInformation{};
+    BOOL created = CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, startupInfo.lpAttributeList != nullptr,
+        creationFlags, nullptr, nullptr, &startupInfo.StartupInfo, &processInformation);
+
+    DeleteProcThreadAttributeList(attributeList);
+    closeInheritedHandles();
+    if (!created) {
+        return nullptr;
+    }
+    CloseHandle(processInformation.hThread);
+
+    return std::unique_ptr<Process>(new Process(std::make_unique<detail::ProcessHandle>(
+        reinterpret_cast<FileDescriptor::NativeHandle>(processInformation.hProcess), spawnTime)));
+}
+
 } // namespace shelly::platform
@@ -1,6 +1,50 @@
 #include "WindowsProcessHandle.hpp"
 
+#include <windows.h>
+#include <psapi.h>
+
 namespace shelly::platform::detail
 {
-    
+
+namespace {
+
+/// @brief Converts a duration in 100 nanosecond intervals, as reported by GetProcessTimes.
+std::chrono::microseconds toMicroseconds(const FILETIME& time) {
+    ULONGLONG intervals = (static_cast<ULONGLONG>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    return std::chrono::microseconds(intervals / 10);
+}
+
+} // namespace
+
+int ProcessHandle::wait() {
+    if (exitStatus.has_value()) {
+        return *exitStatus;
+    }
+
+    HANDLE handle = reinterpret_cast<HANDLE>(process.getNativeHandle());
+    DWORD exitCode = 0;
+    if (WaitForSingleObject(handle, INFINITE) != WAIT_OBJECT_0 || !GetExitCodeProcess(handle, &exitCode)) {
+        exitStatus = 127;
+        return *exitStatus;
+    }
+
+    statistics.wallTime = std::chrono::steady_clock::now() - spawnTime;
+    FILETIME creationTime;
+    FILETIME exitTime;
+    FILETIME kernelTime;
+    FILETIME userTime;
+    if (GetProcessTimes(handle, &creationTime, &exitTime, &kernelTime, &userTime)) {
+        statistics.userTime = toMicroseconds(userTime);
+        statistics.systemTime = toMicroseconds(kernelTime);
+    }
+    /// @note Windows does not tell soft page faults from hard ones, and does not count context switches, so those stay zero.
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (K32GetProcessMemoryInfo(handle, &counters, sizeof(counters))) {
+        statistics.maxResidentSetKilobytes = static_cast<long>(counters.PeakWorkingSetSize / 1024);
+    }
+
+    exitStatus = static_cast<int>(exitCode);
+    return *exitStatus;
+}
+
 } // namespace shelly::platform::detail
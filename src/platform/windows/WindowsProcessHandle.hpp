@@ -1,12 +1,38 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
+
+#include "shelly/platform/FileDescriptor.hpp"
+#include "shelly/platform/Process.hpp"
+
 namespace shelly::platform::detail
 {
     
 class ProcessHandle {
 public:
+
+    /// @brief Instantiate a handle for a spawned child process. Takes ownership of the process handle.
+    /// @param process   Process handle of the child.
+    /// @param spawnTime Time just before the child was spawned.
+    ProcessHandle(FileDescriptor::NativeHandle process, std::chrono::steady_clock::time_point spawnTime) : process(process), spawnTime(spawnTime) {}
+
+    /// @brief Waits for the child to exit, and collects its resource usage.
+    /// @return Exit code of the child, or 127 if it could not be waited for.
+    int wait();
+
+    inline FileDescriptor::NativeHandle getProcess() const { return process.getNativeHandle(); }
+    inline bool isWaited() const { return exitStatus.has_value(); }
+    inline const ProcessStatistics& getStatistics() const { return statistics; }
+
 protected:
 private:
+
+    FileDescriptor process;
+    std::chrono::steady_clock::time_point spawnTime;
+    std::optional<int> exitStatus;
+    ProcessStatistics statistics;
+
 };
 
 } // namespace shelly::platform::detail
@@ -0,0 +1,14 @@
+#include "shelly/platform/Terminal.hpp"
+
+#include <cstdio>
+
+#include <io.h>
+
+namespace shelly::platform
+{
+
+bool isStandardInputTerminal() {
+    return _isatty(_fileno(stdin)) != 0;
+}
+
+} // namespace shelly::platform
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include "shelly/ast/lexer/Lexer.hpp"
+#include "shelly/diagnostics/AllocationTracker.hpp"
 
 using namespace shelly::ast;
 using LexerTestParam = std::pair<std::string, std::vector<Token>>;
@@ -80,6 +81,63 @@ TEST(LexerTest, LexerPeekConsumeApiVerificationWhenHasTokensLeftIsTrue) {
     }
 }
 
+TEST(LexerTest, LexerDoesNotAllocateWhenLexingLongLine) {
+    if (!shelly::diagnostics::isAllocationTrackingEnabled()) {
+        GTEST_SKIP() << "Allocation tracking is disabled";
+    }
+
+    std::string input;
+    for (int i = 0; i < 25; i++) {
+        input += "a-long-argument-beyond-small-string-capacity 2>err | <in ";
+    }
+
+    shelly::diagnostics::AllocationScope scope;
+
+    Lexer lexer(input);
+    std::size_t tokenCount = 0;
+    while (lexer.hasTokensLeft()) {
+        Token token = lexer.consume().value();
+        Token tokenCopy = token;
+        tokenCount += tokenCopy.is(token.getKind());
+    }
+
+    std::size_t allocationCount = scope.getAllocationCount();
+
+    EXPECT_EQ(tokenCount, 150);
+    EXPECT_EQ(allocationCount, 0);
+}
+
+TEST(LexerTest, LexerLexesLineLongerThan64KiB) {
+    std::string input = "echo";
+    for (int i = 0; i < 40000; i++) {
+        input += " x";
+    }
+    input += " | wc";
+
+    Lexer lexer(input);
+    std::size_t tokenCount = 0;
+    std::optional<Token> lastToken;
+    while (lexer.hasTokensLeft()) {
+        lastToken = lexer.consume();
+        tokenCount++;
+    }
+
+    ASSERT_TRUE(lastToken.has_value());
+    EXPECT_EQ(tokenCount, 40003);
+    expectTokensEqual(Token(TokenKind::STRING_LITERAL, Location(1, input.size() - 1), "wc"), *lastToken);
+}
+
+TEST(LexerTest, LexerHasTokensLeftApiVerificationWhenLastTokenIsPeeked) {
+    std::string input = "test.cmd";
+
+    Lexer lexer(input);
+    lexer.peek();
+
+    EXPECT_TRUE(lexer.hasTokensLeft());
+    EXPECT_TRUE(lexer.consume().has_value());
+    EXPECT_FALSE(lexer.hasTokensLeft());
+}
+
 TEST(LexerTest, LexerHasTokensLeftApiVerificationWhenInputIsEmptyString) {
     std::string input = "";
 
@@ -204,6 +262,46 @@ INSTANTIATE_TEST_SUITE_P(
     )
 );
 
+INSTANTIATE_TEST_SUITE_P(
+    HereDocumentsAndHereStringsLexedCorrectly,
+    LexerTest,
+    ::testing::Values(
+        LexerTestParam{
+            "cat <<EOF",
+            {
+                Token(TokenKind::STRING_LITERAL, Location(1, 1), "cat"),
+                Token(TokenKind::HERE_DOCUMENT, Location(1, 5)),
+                Token(TokenKind::STRING_LITERAL, Location(1, 7), "EOF"),
+            }
+        },
+        LexerTestParam{
+            "cat <<-EOF",
+            {
+                Token(TokenKind::STRING_LITERAL, Location(1, 1), "cat"),
+                Token(TokenKind::HERE_DOCUMENT_STRIP_TABS, Location(1, 5)),
+                Token(TokenKind::STRING_LITERAL, Location(1, 8), "EOF"),
+            }
+        },
+        LexerTestParam{
+            "cat<<<word",
+            {
+                Token(TokenKind::STRING_LITERAL, Location(1, 1), "cat"),
+                Token(TokenKind::HERE_STRING, Location(1, 4)),
+                Token(TokenKind::STRING_LITERAL, Location(1, 7), "word"),
+            }
+        },
+        LexerTestParam{
+            "cat << -x <",
+            {
+                Token(TokenKind::STRING_LITERAL, Location(1, 1), "cat"),
+                Token(TokenKind::HERE_DOCUMENT, Location(1, 5)),
+                Token(TokenKind::STRING_LITERAL, Location(1, 8), "-x"),
+                Token(TokenKind::INPUT_REDIRECTION, Location(1, 11)),
+            }
+        }
+    )
+);
+
 TEST_P(LexerTest, LexerTokensTests) {
     const auto& [input, expectedTokens] = GetParam();
 
@@ -0,0 +1,211 @@
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shelly/ast/parser/CompiledScript.hpp"
+#include "shelly/ast/parser/Parser.hpp"
+#include "shelly/diagnostics/AllocationTracker.hpp"
+
+using namespace shelly::ast;
+
+std::optional<PipelineASTNode> parseInput(const std::string& input) {
+    Lexer lexer(input);
+    return Parser(lexer).parse();
+}
+
+constexpr std::size_t countCommands(std::string_view input) {
+    Lexer lexer(input);
+    return Parser(lexer).parse().value().getCommands().size();
+}
+
+constexpr bool isMalformed(std::string_view input) {
+    Lexer lexer(input);
+    return !Parser(lexer).parse().has_value();
+}
+
+static_assert(countCommands("") == 0);
+static_assert(countCommands("ls -la") == 1);
+static_assert(countCommands("cat <input | sort | uniq >output 2>errors") == 3);
+static_assert(isMalformed("| sort"));
+static_assert(countCommands("cat <<EOF | sort <<<word") == 2);
+
+TEST(ParserTest, ParserParsesEmptyInputIntoEmptyPipeline) {
+    std::optional<PipelineASTNode> pipeline = parseInput(" \t");
+
+    ASSERT_TRUE(pipeline.has_value());
+    EXPECT_TRUE(pipeline->getCommands().empty());
+}
+
+TEST(ParserTest, ParserParsesCommandArgumentsAndRedirections) {
+    std::optional<PipelineASTNode> pipeline = parseInput("test.cmd arg1 >output <input 2>errors arg2");
+
+    ASSERT_TRUE(pipeline.has_value());
+    ASSERT_EQ(pipeline->getCommands().size(), 1);
+
+    const CommandASTNode& command = pipeline->getCommands()[0];
+    EXPECT_EQ(command.getArguments(), (std::vector<std::string>{"test.cmd", "arg1", "arg2"}));
+    EXPECT_EQ(command.getInputRedirection(), "input");
+    EXPECT_EQ(command.getOutputRedirection(), "output");
+    EXPECT_EQ(command.getErrorRedirection(), "errors");
+}
+
+TEST(ParserTest, ParserSplitsPipelineIntoCommands) {
+    std::optional<PipelineASTNode> pipeline = parseInput("test1.cmd a|test2.cmd b >output");
+
+    ASSERT_TRUE(pipeline.has_value());
+    ASSERT_EQ(pipeline->getCommands().size(), 2);
+
+    EXPECT_EQ(pipeline->getCommands()[0].getArguments(), (std::vector<std::string>{"test1.cmd", "a"}));
+    EXPECT_FALSE(pipeline->getCommands()[0].getOutputRedirection().has_value());
+    EXPECT_EQ(pipeline->getCommands()[1].getArguments(), (std::vector<std::string>{"test2.cmd", "b"}));
+    EXPECT_EQ(pipeline->getCommands()[1].getOutputRedirection(), "output");
+}
+
+TEST(ParserTest, ParserRecognizesTimeKeywordOnlyAsFirstToken) {
+    std::optional<PipelineASTNode> timed = parseInput("time test1.cmd | test2.cmd time");
+    std::optional<PipelineASTNode> untimed = parseInput("test1.cmd time");
+    std::optional<PipelineASTNode> empty = parseInput("time");
+
+    ASSERT_TRUE(timed.has_value());
+    EXPECT_TRUE(timed->isTimed());
+    ASSERT_EQ(timed->getCommands().size(), 2);
+    EXPECT_EQ(timed->getCommands()[0].getArguments(), (std::vector<std::string>{"test1.cmd"}));
+    EXPECT_EQ(timed->getCommands()[1].getArguments(), (std::vector<std::string>{"test2.cmd", "time"}));
+
+    ASSERT_TRUE(untimed.has_value());
+    EXPECT_FALSE(untimed->isTimed());
+
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_TRUE(empty->isTimed());
+    EXPECT_TRUE(empty->getCommands().empty());
+}
+
+TEST(ParserTest, ParserParsesHereDocumentsAndHereStrings) {
+    std::optional<PipelineASTNode> pipeline = parseInput("test1.cmd <<EOF | test2.cmd <<-END | test3.cmd <<<word");
+
+    ASSERT_TRUE(pipeline.has_value());
+    ASSERT_EQ(pipeline->getCommands().size(), 3);
+
+    const std::optional<HereDocument>& document = pipeline->getCommands()[0].getHereDocument();
+    ASSERT_TRUE(document.has_value());
+    EXPECT_EQ(document->kind, HereDocument::Kind::Document);
+    EXPECT_EQ(document->word, "EOF");
+    EXPECT_TRUE(document->isDelimited());
+
+    const std::optional<HereDocument>& strippedDocument = pipeline->getCommands()[1].getHereDocument();
+    ASSERT_TRUE(strippedDocument.has_value());
+    EXPECT_EQ(strippedDocument->kind, HereDocument::Kind::DocumentStripTabs);
+    EXPECT_EQ(strippedDocument->word, "END");
+
+    const std::optional<HereDocument>& hereString = pipeline->getCommands()[2].getHereDocument();
+    ASSERT_TRUE(hereString.has_value());
+    EXPECT_EQ(hereString->kind, HereDocument::Kind::String);
+    EXPECT_EQ(hereString->word, "word");
+    EXPECT_FALSE(hereString->isDelimited());
+}
+
+TEST(ParserTest, ParserKeepsOnlyTheLastInputRedirection) {
+    std::optional<PipelineASTNode> hereDocumentLast = parseInput("test.cmd <input <<EOF");
+    std::optional<PipelineASTNode> fileLast = parseInput("test.cmd <<EOF <input");
+
+    ASSERT_TRUE(hereDocumentLast.has_value());
+    EXPECT_FALSE(hereDocumentLast->getCommands()[0].getInputRedirection().has_value());
+    EXPECT_TRUE(hereDocumentLast->getCommands()[0].getHereDocument().has_value());
+
+    ASSERT_TRUE(fileLast.has_value());
+    EXPECT_EQ(fileLast->getCommands()[0].getInputRedirection(), "input");
+    EXPECT_FALSE(fileLast->getCommands()[0].getHereDocument().has_value());
+}
+
+TEST(ParserTest, ParserAllocatesOnlyForTheAST) {
+    if (!shelly::diagnostics::isAllocationTrackingEnabled()) {
+        GTEST_SKIP() << "Allocation tracking is disabled";
+    }
+
+    std::string input = "test1.cmd a | test2.cmd >output";
+
+    shelly::diagnostics::AllocationScope scope;
+    std::optional<PipelineASTNode> pipeline = parseInput(input);
+    std::size_t allocationCount = scope.getAllocationCount();
+
+    /// @note Arguments and redirection targets fit into the small string buffer, so only vectors allocate:
+    ///       two growths of the first command's arguments, one for the second, and two for the pipeline.
+    ASSERT_TRUE(pipeline.has_value());
+    EXPECT_LE(allocationCount, 5);
+}
+
+class ParserMalformedTest : public ::testing::TestWithParam<std::string> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    ParserRejectsMalformedInput,
+    ParserMalformedTest,
+    ::testing::Values(
+        "| test.cmd",
+        "test.cmd |",
+        "test1.cmd || test2.cmd",
+        "test.cmd >",
+        "test.cmd > | test2.cmd",
+        "test.cmd < >output",
+        ">output",
+        "time | test.cmd",
+        "test.cmd <<",
+        "test.cmd <<- | test2.cmd",
+        "<<<word"
+    )
+);
+
+TEST_P(ParserMalformedTest, ParserMalformedInputTests) {
+    EXPECT_FALSE(parseInput(GetParam()).has_value());
+}
+
+constexpr std::string_view testScript =
+    "# comment line\n"
+    "\n"
+    "test1.cmd a b\n"
+    "   # indented comment\n"
+    "test2.cmd <input | test3.cmd 2>errors >output";
+
+constexpr auto compiledTestScript = compileScript<testScript>();
+
+static_assert(compiledTestScript.getPipelines().size() == 2);
+
+TEST(CompiledScriptTest, CompiledScriptMatchesParsedScript) {
+    ASSERT_EQ(compiledTestScript.getPipelines().size(), 2);
+
+    const CompiledPipeline& first = compiledTestScript.getPipelines()[0];
+    ASSERT_EQ(compiledTestScript.getCommands(first).size(), 1);
+
+    const CompiledCommand& firstCommand = compiledTestScript.getCommands(first)[0];
+    ASSERT_EQ(firstCommand.argumentCount, 3);
+    EXPECT_EQ(compiledTestScript.getArgument(firstCommand, 0), "test1.cmd");
+    EXPECT_EQ(compiledTestScript.getArgument(firstCommand, 1), "a");
+    EXPECT_EQ(compiledTestScript.getArgument(firstCommand, 2), "b");
+    EXPECT_FALSE(compiledTestScript.getRedirection(firstCommand.inputRedirection).has_value());
+
+    const CompiledPipeline& second = compiledTestScript.getPipelines()[1];
+    ASSERT_EQ(compiledTestScript.getCommands(second).size(), 2);
+
+    const CompiledCommand& secondCommand = compiledTestScript.getCommands(second)[0];
+    ASSERT_EQ(secondCommand.argumentCount, 1);
+    EXPECT_EQ(compiledTestScript.getArgument(secondCommand, 0), "test2.cmd");
+    EXPECT_EQ(compiledTestScript.getRedirection(secondCommand.inputRedirection), "input");
+
+    const CompiledCommand& thirdCommand = compiledTestScript.getCommands(second)[1];
+    ASSERT_EQ(thirdCommand.argumentCount, 1);
+    EXPECT_EQ(compiledTestScript.getArgument(thirdCommand, 0), "test3.cmd");
+    EXPECT_EQ(compiledTestScript.getRedirection(thirdCommand.outputRedirection), "output");
+    EXPECT_EQ(compiledTestScript.getRedirection(thirdCommand.errorRedirection), "errors");
+}
+
+TEST(CompiledScriptTest, CompiledScriptMeasuresMalformedScriptAsInvalid) {
+    EXPECT_FALSE(detail::measureScript("test.cmd\ntest.cmd |\n").valid);
+}
+
+TEST(CompiledScriptTest, CompiledScriptMeasuresScriptWithHereDocumentAsInvalid) {
+    EXPECT_FALSE(detail::measureScript("test.cmd <<EOF\nbody\nEOF\n").valid);
+    EXPECT_FALSE(detail::measureScript("test.cmd <<<word\n").valid);
+}
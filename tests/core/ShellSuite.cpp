@@ -0,0 +1,282 @@
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "shelly/core/Shell.hpp"
+#include "shelly/diagnostics/AllocationTracker.hpp"
+
+using namespace shelly::core;
+using ShellTestParam = std::pair<std::string, int>;
+class ShellTest : public ::testing::TestWithParam<ShellTestParam> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    ShellCommandStringReturnsExpectedExitStatus,
+    ShellTest,
+    ::testing::Values(
+        ShellTestParam{"", 0},
+        ShellTestParam{"true", 0},
+        ShellTestParam{"false", 1},
+        ShellTestParam{":", 0},
+        ShellTestParam{"false\ntrue", 0},
+        ShellTestParam{"true\nfalse", 1},
+        ShellTestParam{"# comment\n\nfalse\n", 1},
+        ShellTestParam{"exit 3\ntrue", 3},
+        ShellTestParam{"false\nexit", 1},
+        ShellTestParam{"exit abc", 2},
+        ShellTestParam{"true | exit 4 | false", 1},
+        ShellTestParam{"| true", 2},
+        ShellTestParam{"true\ntrue >\ntrue", 2},
+        ShellTestParam{"shelly-test-program-that-does-not-exist", 127},
+        ShellTestParam{"true < /shelly/test/file/that/does/not/exist", 1},
+        ShellTestParam{": > /shelly/test/directory/that/does/not/exist/file", 1},
+        ShellTestParam{"false 2> /shelly/test/directory/that/does/not/exist/file", 1},
+        ShellTestParam{"true < /shelly/test/file/that/does/not/exist | true", 0},
+        ShellTestParam{"true | true < /shelly/test/file/that/does/not/exist", 1},
+        ShellTestParam{"true < /dev/null > /dev/null 2> /dev/null", 0}
+    )
+);
+
+TEST_P(ShellTest, ShellCommandStringTests) {
+    const auto& [commandString, expectedExitStatus] = GetParam();
+
+    Shell shell;
+
+    EXPECT_EQ(shell.runCommandString(commandString), expectedExitStatus);
+}
+
+TEST(ShellTest, ShellRunScriptFileReturnsNotFoundWhenFileDoesNotExist) {
+    Shell shell;
+
+    EXPECT_EQ(shell.runScriptFile("/shelly/test/script/that/does/not/exist.sh"), 127);
+}
+
+TEST(ShellTest, ShellRunsLineLongerThan64KiB) {
+    Shell shell;
+
+    EXPECT_EQ(shell.runCommandString("true " + std::string(70000, 'x')), 0);
+    EXPECT_EQ(shell.runCommandString("false " + std::string(70000, 'x') + "\nexit 3"), 3);
+}
+
+TEST(ShellTest, ShellBuiltinAllocatesOnlyForTheAST) {
+    if (!shelly::diagnostics::isAllocationTrackingEnabled()) {
+        GTEST_SKIP() << "Allocation tracking is disabled";
+    }
+
+    Shell shell;
+
+    shelly::diagnostics::AllocationScope scope;
+    int exitStatus = shell.runCommandString("true");
+    std::size_t allocationCount = scope.getAllocationCount();
+
+    /// @note The arguments vector and the pipeline vector are the only allocations. The builtin itself allocates nothing.
+    EXPECT_EQ(exitStatus, 0);
+    EXPECT_LE(allocationCount, 2);
+}
+
+#ifndef _WIN32
+
+#include <unistd.h>
+
+std::string readFile(const std::string& path) {
+    std::string contents;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return contents;
+    }
+    char buffer[4096];
+    std::size_t readCount;
+    while ((readCount = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.append(buffer, readCount);
+    }
+    std::fclose(file);
+    return contents;
+}
+
+using ShellHereDocumentTestParam = std::pair<std::string, std::string>;
+class ShellHereDocumentTest : public ::testing::TestWithParam<ShellHereDocumentTestParam> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    ShellHereDocumentFeedsCommandInput,
+    ShellHereDocumentTest,
+    ::testing::Values(
+        ShellHereDocumentTestParam{"cat <<EOF >OUTPUT\nfirst\n  second\nEOF\n", "first\n  second\n"},
+        ShellHereDocumentTestParam{"cat <<-EOF >OUTPUT\n\t\tfirst\n\tsecond\n\tEOF\n", "first\nsecond\n"},
+        ShellHereDocumentTestParam{"cat <<<word >OUTPUT", "word\n"},
+        ShellHereDocumentTestParam{"cat <<A <<B >OUTPUT\nignored\nA\nused\nB\n", "used\n"},
+        ShellHereDocumentTestParam{"cat <<EOF | cat >OUTPUT\npiped\nEOF\n", "piped\n"},
+        ShellHereDocumentTestParam{"cat <<EOF >OUTPUT\nunterminated\n", "unterminated\n"},
+        ShellHereDocumentTestParam{"cat <<EOF >OUTPUT\nEOF\n", ""}
+    )
+);
+
+TEST_P(ShellHereDocumentTest, ShellHereDocumentTests) {
+    std::string outputPath = ::testing::TempDir() + "shelly_here_document_test.txt";
+    std::remove(outputPath.c_str());
+
+    std::string commandString = GetParam().first;
+    commandString.replace(commandString.find("OUTPUT"), 6, outputPath);
+
+    Shell shell;
+
+    EXPECT_EQ(shell.runCommandString(commandString), 0);
+    EXPECT_EQ(readFile(outputPath), GetParam().second);
+    std::remove(outputPath.c_str());
+}
+
+TEST(ShellTest, ShellBuiltinOutputRedirectionCreatesAndTruncatesFile) {
+    std::string outputPath = ::testing::TempDir() + "shelly_builtin_redirection_test.txt";
+    std::remove(outputPath.c_str());
+
+    Shell shell;
+
+    EXPECT_EQ(shell.runCommandString(": > " + outputPath), 0);
+    std::FILE* file = std::fopen(outputPath.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    std::fclose(file);
+
+    file = std::fopen(outputPath.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("contents", file);
+    std::fclose(file);
+
+    EXPECT_EQ(shell.runCommandString(": > " + outputPath), 0);
+    EXPECT_EQ(readFile(outputPath), "");
+    EXPECT_EQ(std::remove(outputPath.c_str()), 0);
+}
+
+TEST(ShellTest, ShellExecutesLinesThatFollowHereDocumentBody) {
+    Shell shell;
+
+    EXPECT_EQ(shell.runCommandString("cat <<EOF >/dev/null\nfalse\nEOF\nfalse"), 1);
+    EXPECT_EQ(shell.runCommandString("cat <<EOF >/dev/null\nfalse\nEOF\n"), 0);
+}
+
+TEST(ShellTest, ShellPassesLargeHereDocumentFromScriptFile) {
+    std::string scriptPath = ::testing::TempDir() + "shelly_here_document_test.sh";
+    std::string outputPath = ::testing::TempDir() + "shelly_here_document_test.txt";
+
+    std::string body;
+    for (int i = 0; i < 10000; i++) {
+        body += "line " + std::to_string(i) + " of a here-document larger than a pipe buffer\n";
+    }
+
+    std::FILE* script = std::fopen(scriptPath.c_str(), "wb");
+    ASSERT_NE(script, nullptr);
+    std::string contents = "cat <<EOF >" + outputPath + "\n" + body + "EOF\nexit 5\n";
+    std::fwrite(contents.data(), 1, contents.size(), script);
+    std::fclose(script);
+
+    Shell shell;
+
+    EXPECT_EQ(shell.runScriptFile(scriptPath), 5);
+    EXPECT_EQ(readFile(outputPath), body);
+    std::remove(scriptPath.c_str());
+    std::remove(outputPath.c_str());
+}
+
+TEST(ShellTest, ShellKeepsRunningScriptFileThatTruncatesItself) {
+    std::string scriptPath = ::testing::TempDir() + "shelly_truncated_script_test.sh";
+
+    std::FILE* script = std::fopen(scriptPath.c_str(), "wb");
+    ASSERT_NE(script, nullptr);
+    std::string contents = ": > " + scriptPath + "\nexit 3\n";
+    std::fwrite(contents.data(), 1, contents.size(), script);
+    std::fclose(script);
+
+    Shell shell;
+
+    /// @note Lines already read before the truncation still run, as in other shells.
+    EXPECT_EQ(shell.runScriptFile(scriptPath), 3);
+    std::remove(scriptPath.c_str());
+}
+
+TEST(ShellTest, ShellRunsStandardInputLinesAsTheyArrive) {
+    std::string outputPath = ::testing::TempDir() + "shelly_standard_input_test.txt";
+    std::remove(outputPath.c_str());
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    int savedStandardInput = dup(STDIN_FILENO);
+    dup2(fds[0], STDIN_FILENO);
+    close(fds[0]);
+
+    /// @note The producer holds the rest of the script back until the first command has run.
+    bool ranBeforeEndOfInput = false;
+    std::thread producer([&]() {
+        std::string firstLines = "cat <<EOF >" + outputPath + "\nfirst\nEOF\n";
+        write(fds[1], firstLines.data(), firstLines.size());
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!ranBeforeEndOfInput && std::chrono::steady_clock::now() < deadline) {
+            ranBeforeEndOfInput = readFile(outputPath) == "first\n";
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        write(fds[1], "exit 4\n", 7);
+        close(fds[1]);
+    });
+
+    Shell shell;
+    int exitStatus = shell.run();
+
+    producer.join();
+    dup2(savedStandardInput, STDIN_FILENO);
+    close(savedStandardInput);
+    std::remove(outputPath.c_str());
+
+    EXPECT_EQ(exitStatus, 4);
+    EXPECT_TRUE(ranBeforeEndOfInput);
+}
+
+TEST(ShellTest, ShellRecordsPipelineMetricsWhenMetricsFileIsConfigured) {
+    std::string metricsPath = ::testing::TempDir() + "shelly_metrics_test.jsonl";
+    std::remove(metricsPath.c_str());
+
+    setenv("SHELLY_METRICS_FILE", metricsPath.c_str(), 1);
+    Shell shell;
+    unsetenv("SHELLY_METRICS_FILE");
+
+    EXPECT_EQ(shell.runCommandString("true | false\ntime false"), 1);
+
+    std::string contents = readFile(metricsPath);
+    std::remove(metricsPath.c_str());
+
+    std::size_t firstLineEnd = contents.find('\n');
+    ASSERT_NE(firstLineEnd, std::string::npos);
+    std::string firstLine = contents.substr(0, firstLineEnd);
+    std::string secondLine = contents.substr(firstLineEnd + 1);
+
+    EXPECT_NE(firstLine.find("\"command\":\"true | false\""), std::string::npos);
+    EXPECT_NE(firstLine.find("\"status\":1"), std::string::npos);
+    EXPECT_NE(firstLine.find("\"max_rss_kb\":"), std::string::npos);
+    EXPECT_NE(secondLine.find("\"command\":\"false\""), std::string::npos);
+    EXPECT_NE(secondLine.find("\"builtin\":true"), std::string::npos);
+}
+
+TEST(ShellTest, ShellAddsPrometheusMetricsToTotalsOfEarlierShells) {
+    std::string metricsPath = ::testing::TempDir() + "shelly_metrics_test.prom";
+    std::remove(metricsPath.c_str());
+
+    setenv("SHELLY_METRICS_FILE", metricsPath.c_str(), 1);
+    setenv("SHELLY_METRICS_FORMAT", "prometheus", 1);
+    for (int i = 0; i < 2; i++) {
+        Shell shell;
+        EXPECT_EQ(shell.runCommandString("true\nfalse"), 1);
+    }
+    unsetenv("SHELLY_METRICS_FILE");
+    unsetenv("SHELLY_METRICS_FORMAT");
+
+    std::string contents = readFile(metricsPath);
+    std::remove(metricsPath.c_str());
+    std::remove((metricsPath + ".lock").c_str());
+
+    EXPECT_NE(contents.find("shelly_command_runs_total{program=\"true\"} 2.000000\n"), std::string::npos);
+    EXPECT_NE(contents.find("shelly_command_runs_total{program=\"false\"} 2.000000\n"), std::string::npos);
+    EXPECT_NE(contents.find("shelly_command_failures_total{program=\"false\"} 2.000000\n"), std::string::npos);
+    EXPECT_NE(contents.find("shelly_command_failures_total{program=\"true\"} 0.000000\n"), std::string::npos);
+}
+
+#endif
@@ -0,0 +1,96 @@
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shelly/diagnostics/AllocationTracker.hpp"
+
+using namespace shelly::diagnostics;
+
+/// @brief Stores the pointer into a volatile, so the compiler cannot elide the allocation under test.
+/// @note The volatile store is the observable use, so the sink is never read.
+void escape(void* pointer) {
+    [[maybe_unused]] static void* volatile sink;
+    sink = pointer;
+}
+
+class AllocationTrackerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!isAllocationTrackingEnabled()) {
+            GTEST_SKIP() << "Allocation tracking is disabled";
+        }
+    }
+};
+
+TEST_F(AllocationTrackerTest, AllocationScopeCountsNewAndDelete) {
+    AllocationScope scope;
+
+    auto value = std::make_unique<long>(1);
+    escape(value.get());
+    value.reset();
+
+    std::size_t allocationCount = scope.getAllocationCount();
+    std::size_t deallocationCount = scope.getDeallocationCount();
+    std::size_t allocatedBytes = scope.getAllocatedBytes();
+
+    EXPECT_EQ(allocationCount, 1);
+    EXPECT_EQ(deallocationCount, 1);
+    EXPECT_EQ(allocatedBytes, sizeof(long));
+}
+
+TEST_F(AllocationTrackerTest, AllocationScopeCountsNothingWhenNothingIsAllocated) {
+    AllocationScope scope;
+
+    int values[4] = {1, 2, 3, 4};
+    int sum = 0;
+    for (int value : values) {
+        sum += value;
+    }
+
+    std::size_t allocationCount = scope.getAllocationCount();
+
+    EXPECT_EQ(sum, 10);
+    EXPECT_EQ(allocationCount, 0);
+}
+
+TEST_F(AllocationTrackerTest, NestedAllocationScopesCountIndependently) {
+    AllocationScope outerScope;
+    std::vector<int> outer(16);
+    escape(outer.data());
+
+    std::size_t innerAllocationCount;
+    {
+        AllocationScope innerScope;
+        std::vector<int> inner(16);
+        escape(inner.data());
+        innerAllocationCount = innerScope.getAllocationCount();
+    }
+
+    std::size_t outerAllocationCount = outerScope.getAllocationCount();
+
+    EXPECT_EQ(innerAllocationCount, 1);
+    EXPECT_EQ(outerAllocationCount, 2);
+}
+
+TEST_F(AllocationTrackerTest, AllocationScopeCountsArrayAndAlignedAllocations) {
+    struct alignas(64) Aligned { char data[64]; };
+
+    AllocationScope scope;
+
+    char* array = new char[32];
+    escape(array);
+    delete[] array;
+
+    Aligned* aligned = new Aligned();
+    escape(aligned);
+    delete aligned;
+
+    std::size_t allocationCount = scope.getAllocationCount();
+    std::size_t deallocationCount = scope.getDeallocationCount();
+
+    EXPECT_EQ(allocationCount, 2);
+    EXPECT_EQ(deallocationCount, 2);
+}
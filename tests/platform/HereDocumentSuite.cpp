@@ -0,0 +1,52 @@
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include "shelly/platform/FileDescriptor.hpp"
+#include "shelly/platform/HereDocument.hpp"
+
+using namespace shelly::platform;
+
+std::string readAll(const FileDescriptor& input) {
+    std::string contents;
+    char buffer[4096];
+    ssize_t readCount;
+    while ((readCount = read(static_cast<int>(input.getNativeHandle()), buffer, sizeof(buffer))) > 0) {
+        contents.append(buffer, static_cast<std::size_t>(readCount));
+    }
+    return contents;
+}
+
+std::string makeLargeBody() {
+    std::string body;
+    while (body.size() <= 4 * pipedHereDocumentLimit) {
+        body += "line " + std::to_string(body.size()) + "\n";
+    }
+    return body;
+}
+
+TEST(HereDocumentTest, SmallBodyIsPassedThroughPipe) {
+    std::string_view body[] = {"first ", "second\n"};
+    std::unique_ptr<FileDescriptor> input = makeHereDocumentInput(body);
+
+    ASSERT_NE(input, nullptr);
+    EXPECT_EQ(lseek(static_cast<int>(input->getNativeHandle()), 0, SEEK_END), -1);
+    EXPECT_EQ(readAll(*input), "first second\n");
+}
+
+TEST(HereDocumentTest, LargeBodyIsSeekableAndCannotBeModified) {
+    std::string body = makeLargeBody();
+    std::string_view parts[] = {body, "tail\n"};
+    std::unique_ptr<FileDescriptor> input = makeHereDocumentInput(parts);
+
+    ASSERT_NE(input, nullptr);
+    int fd = static_cast<int>(input->getNativeHandle());
+    EXPECT_EQ(lseek(fd, 0, SEEK_END), static_cast<off_t>(body.size() + 5));
+    EXPECT_EQ(write(fd, "x", 1), -1);
+    ASSERT_EQ(lseek(fd, 0, SEEK_SET), 0);
+    EXPECT_EQ(readAll(*input), body + "tail\n");
+}
@@ -0,0 +1,80 @@
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "shelly/platform/IOEngine.hpp"
+
+using namespace shelly::platform;
+
+/// @brief Runs every test against each backend, selected through SHELLY_IO_BACKEND.
+class IOEngineTest : public ::testing::TestWithParam<const char*> {
+protected:
+
+    /// @note An unavailable backend falls back to the next one. Its tests are skipped, so they never pass
+    ///       while testing another backend.
+    void SetUp() override {
+        setenv("SHELLY_IO_BACKEND", GetParam(), 1);
+        engine = makeIOEngine();
+        unsetenv("SHELLY_IO_BACKEND");
+        ASSERT_NE(engine, nullptr);
+
+        std::string requested = GetParam();
+        IOBackend expected = requested == "io_uring" ? IOBackend::IoUring : IOBackend::Blocking;
+        if (engine->getBackend() != expected) {
+            GTEST_SKIP() << requested << " is unavailable";
+        }
+    }
+
+    std::string temporaryPath(const std::string& name) const {
+        return ::testing::TempDir() + "shelly_io_engine_" + GetParam() + "_" + name;
+    }
+
+    std::unique_ptr<IOEngine> engine;
+};
+
+TEST(IOEngineTest, BlockingBackendIsUsedByDefault) {
+    unsetenv("SHELLY_IO_BACKEND");
+    std::unique_ptr<IOEngine> engine = makeIOEngine();
+
+    EXPECT_EQ(engine->getBackend(), IOBackend::Blocking);
+}
+
+TEST_P(IOEngineTest, OpenRequestsInOneBatchSucceedOrFailIndependently) {
+    std::string existingPath = temporaryPath("existing.txt");
+    std::string createdPath = temporaryPath("created.txt");
+    std::remove(createdPath.c_str());
+    ASSERT_NE(openFileForWriting(existingPath), nullptr);
+
+    std::vector<IORequest> requests;
+    requests.push_back(IORequest::openForReading(existingPath));
+    requests.push_back(IORequest::openForReading(temporaryPath("missing.txt")));
+    requests.push_back(IORequest::openForWriting(createdPath));
+    engine->submit(requests);
+
+    EXPECT_NE(requests[0].openedFile, nullptr);
+    EXPECT_EQ(requests[0].error, 0);
+    EXPECT_EQ(requests[1].openedFile, nullptr);
+    EXPECT_EQ(requests[1].error, ENOENT);
+    EXPECT_NE(requests[2].openedFile, nullptr);
+    EXPECT_NE(openFileForReading(createdPath), nullptr);
+}
+
+TEST_P(IOEngineTest, BatchesLargerThanTheRingAreCompleted) {
+    std::string path = temporaryPath("many.txt");
+    ASSERT_NE(openFileForWriting(path), nullptr);
+
+    std::vector<IORequest> requests;
+    for (int i = 0; i < 200; i++) {
+        requests.push_back(IORequest::openForReading(path));
+    }
+    engine->submit(requests);
+
+    for (const IORequest& request : requests) {
+        EXPECT_NE(request.openedFile, nullptr);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, IOEngineTest, ::testing::Values("io_uring", "blocking"));
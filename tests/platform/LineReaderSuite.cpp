@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "shelly/platform/LineReader.hpp"
+
+using namespace shelly::platform;
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(contents.data(), 1, contents.size(), file);
+    std::fclose(file);
+}
+
+TEST(LineReaderTest, ReadsLinesLongerThanBufferAndLastLineWithoutNewline) {
+    std::string path = ::testing::TempDir() + "shelly_line_reader_test.txt";
+    std::string longLine(20000, 'x');
+    writeFile(path, "first\n\n" + longLine + "\nlast");
+
+    std::unique_ptr<LineReader> reader = openLineReader(path);
+    ASSERT_NE(reader, nullptr);
+
+    std::string line;
+    ASSERT_TRUE(reader->readLine(line));
+    EXPECT_EQ(line, "first");
+    ASSERT_TRUE(reader->readLine(line));
+    EXPECT_EQ(line, "");
+    ASSERT_TRUE(reader->readLine(line));
+    EXPECT_EQ(line, longLine);
+    ASSERT_TRUE(reader->readLine(line));
+    EXPECT_EQ(line, "last");
+    EXPECT_FALSE(reader->readLine(line));
+    EXPECT_FALSE(reader->hasFailed());
+    std::remove(path.c_str());
+}
+
+TEST(LineReaderTest, FileTruncatedWhileReadingEndsInput) {
+    std::string path = ::testing::TempDir() + "shelly_line_reader_test.txt";
+    std::string contents;
+    for (int i = 0; i < 10000; i++) {
+        contents += "line " + std::to_string(i) + "\n";
+    }
+    writeFile(path, contents);
+
+    std::unique_ptr<LineReader> reader = openLineReader(path);
+    ASSERT_NE(reader, nullptr);
+
+    std::string line;
+    ASSERT_TRUE(reader->readLine(line));
+    EXPECT_EQ(line, "line 0");
+
+    /// @note Lines already in the buffer are still returned, then the input ends without an error.
+    writeFile(path, "");
+    while (reader->readLine(line)) {
+    }
+    EXPECT_FALSE(reader->hasFailed());
+    std::remove(path.c_str());
+}
+
+TEST(LineReaderTest, OpenLineReaderReturnsNullWhenFileDoesNotExist) {
+    EXPECT_EQ(openLineReader("/shelly/test/file/that/does/not/exist.txt"), nullptr);
+}
+
+TEST(LineReaderTest, ConsumedPartOfPeekedInputIsNotReadAgain) {
+    std::string path = ::testing::TempDir() + "shelly_line_reader_test.txt";
+    writeFile(path, "body\nEOF\nnext\n");
+
+    std::unique_ptr<LineReader> reader = openLineReader(path);
+    ASSERT_NE(reader, nullptr);
+
+    std::string_view unread = reader->peek();
+    EXPECT_EQ(unread, "body\nEOF\nnext\n");
+    reader->consume(unread.find("next"));
+
+    std::string line;
+    ASSERT_TRUE(reader->readLine(line));
+    EXPECT_EQ(line, "next");
+    EXPECT_TRUE(reader->peek().empty());
+    EXPECT_FALSE(reader->readLine(line));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,89 @@
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "shelly/platform/Pipe.hpp"
+#include "shelly/platform/Process.hpp"
+
+using namespace shelly::platform;
+
+TEST(ProcessTest, ProcessWaitReturnsExitStatus) {
+    std::unique_ptr<Process> process = ProcessBuilder({"sh", "-c", "exit 7"}).spawn();
+
+    ASSERT_NE(process, nullptr);
+    EXPECT_EQ(process->wait(), 7);
+    EXPECT_EQ(process->wait(), 7);
+}
+
+TEST(ProcessTest, ProcessWaitReturnsSignalStatusWhenTerminatedBySignal) {
+    std::unique_ptr<Process> process = ProcessBuilder({"sh", "-c", "kill -9 $$"}).spawn();
+
+    ASSERT_NE(process, nullptr);
+    EXPECT_EQ(process->wait(), 128 + 9);
+}
+
+TEST(ProcessTest, ProcessBuilderSpawnReturnsNullWhenProgramDoesNotExist) {
+    EXPECT_EQ(ProcessBuilder({"shelly-test-program-that-does-not-exist"}).spawn(), nullptr);
+}
+
+TEST(ProcessTest, ProcessesConnectedWithPipeTransferData) {
+    std::unique_ptr<Pipe> pipe = makePipe();
+    ASSERT_NE(pipe, nullptr);
+
+    std::string outputPath = ::testing::TempDir() + "shelly_process_pipe_test.txt";
+    std::unique_ptr<FileDescriptor> output = openFileForWriting(outputPath);
+    ASSERT_NE(output, nullptr);
+
+    std::unique_ptr<Process> writer = ProcessBuilder({"echo", "piped"}).redirectOutput(pipe->getInputFileDescriptor()).spawn();
+    std::unique_ptr<Process> reader = ProcessBuilder({"cat"}).redirectInput(pipe->getOutputFileDescriptor()).redirectOutput(*output).spawn();
+    ASSERT_NE(writer, nullptr);
+    ASSERT_NE(reader, nullptr);
+
+    pipe.reset();
+    output.reset();
+
+    EXPECT_EQ(writer->wait(), 0);
+    EXPECT_EQ(reader->wait(), 0);
+
+    std::FILE* result = std::fopen(outputPath.c_str(), "r");
+    ASSERT_NE(result, nullptr);
+    char buffer[16] = {};
+    std::fgets(buffer, sizeof(buffer), result);
+    std::fclose(result);
+    std::remove(outputPath.c_str());
+
+    EXPECT_STREQ(buffer, "piped\n");
+}
+
+TEST(ProcessTest, OpenFileForReadingReturnsNullWhenFileDoesNotExist) {
+    EXPECT_EQ(openFileForReading("/shelly/test/file/that/does/not/exist"), nullptr);
+}
+
+TEST(ProcessTest, ProcessStatisticsAreCollectedWhenWaited) {
+    std::unique_ptr<Process> process = ProcessBuilder({"sleep", "0.1"}).spawn();
+    ASSERT_NE(process, nullptr);
+
+    EXPECT_EQ(process->getStatistics().wallTime.count(), 0);
+    EXPECT_EQ(process->wait(), 0);
+
+    EXPECT_GE(process->getStatistics().wallTime, std::chrono::milliseconds(100));
+    EXPECT_GT(process->getStatistics().maxResidentSetKilobytes, 0);
+    EXPECT_GT(process->getStatistics().minorPageFaults, 0);
+}
+
+TEST(ProcessTest, WaitForAllReapsProcessesInExitOrder) {
+    std::unique_ptr<Process> slow = ProcessBuilder({"sleep", "0.3"}).spawn();
+    std::unique_ptr<Process> fast = ProcessBuilder({"true"}).spawn();
+    ASSERT_NE(slow, nullptr);
+    ASSERT_NE(fast, nullptr);
+
+    Process* processes[] = {slow.get(), nullptr, fast.get()};
+    waitForAll(processes);
+
+    EXPECT_GE(slow->getStatistics().wallTime, std::chrono::milliseconds(300));
+    EXPECT_LT(fast->getStatistics().wallTime, std::chrono::milliseconds(300));
+}